@@ -71,6 +71,7 @@ bool App::attach(GSource *gsource)
 {
     if (gsource == NULL)
         return false;
-    g_source_attach(gsource, g_main_loop_get_context(mainLoop()));
+    // without loop (e.g. tasks run by tests), use default context same as g_timeout_add
+    g_source_attach(gsource, mainLoop() ? g_main_loop_get_context(mainLoop()) : NULL);
     return true;
 }
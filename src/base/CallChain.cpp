@@ -21,6 +21,10 @@
 #include "JUtil.h"
 #include "Utils.h"
 #include "Logging.h"
+#include "Tracing.h"
+#include "settings/Settings.h"
+
+#define MAX_BACKOFF_SHIFT   6
 
 using namespace std::placeholders;
 
@@ -35,7 +39,10 @@ static pbnjson::JValue makeResult(bool returnValue, std::string errorText)
 
 CallItem::CallItem()
     : m_chainData(pbnjson::Object()),
-      m_option(0)
+      m_option(0),
+      m_timeout(Settings::instance().getLunaCallTimeout()),
+      m_retries(0),
+      m_retryBackoff(Settings::instance().getLunaCallRetryBackoff())
 {
 }
 
@@ -63,6 +70,32 @@ uint32_t CallItem::getOption() const
     return m_option;
 }
 
+void CallItem::setTimeout(int timeout)
+{
+    m_timeout = std::max(0, timeout);
+}
+
+int CallItem::getTimeout() const
+{
+    return m_timeout;
+}
+
+void CallItem::setRetry(int retries, int backoff)
+{
+    m_retries = std::max(0, retries);
+    m_retryBackoff = std::max(0, backoff);
+}
+
+int CallItem::getRetries() const
+{
+    return m_retries;
+}
+
+int CallItem::getRetryBackoff() const
+{
+    return m_retryBackoff;
+}
+
 void CallItem::setChainData(pbnjson::JValue chainData)
 {
     m_chainData = chainData.duplicate();
@@ -77,10 +110,19 @@ LSCallItem::LSCallItem(const char *serviceName, const char *uri, const char *pay
     : m_serviceName(serviceName),
       m_uri(uri),
       m_payload(payload),
-      m_sessionId(sessionId)
+      m_sessionId(sessionId),
+      m_tries(0),
+      m_token(0),
+      m_timeoutSourceId(0),
+      m_retrySourceId(0)
 {
 }
 
+LSCallItem::~LSCallItem()
+{
+    clearPending();
+}
+
 bool LSCallItem::Call()
 {
     if (!onBeforeCall()) {
@@ -88,9 +130,10 @@ bool LSCallItem::Call()
         return false;
     }
 
+    m_tries = 0;
+
     std::string errorText;
-    LSCaller caller = LSUtils::acquireCaller(m_serviceName);
-    if (!caller.CallOneReply(m_uri.c_str(), m_payload.c_str(), m_sessionId, LSCallItem::handler, this, NULL, errorText)) {
+    if (!send(errorText)) {
         onError(errorText.c_str());
         return false;
     }
@@ -98,6 +141,57 @@ bool LSCallItem::Call()
     return true;
 }
 
+bool LSCallItem::send(std::string &errorText)
+{
+    LSCaller caller = LSUtils::acquireCaller(m_serviceName);
+    if (!caller.CallOneReply(m_uri.c_str(), m_payload.c_str(), m_sessionId,
+                             std::bind(&LSCallItem::onReply, this, _1, _2), &m_token, errorText))
+        return false;
+
+    Tracing::begin("lscall", m_uri);
+    ++m_tries;
+    if (getTimeout() > 0)
+        m_timeoutSourceId = g_timeout_add(getTimeout(), cbTimeout, this);
+
+    return true;
+}
+
+bool LSCallItem::retry()
+{
+    if (m_tries > getRetries())
+        return false;
+
+    guint backoff = getRetryBackoff() << std::min(m_tries - 1, MAX_BACKOFF_SHIFT);
+    LOG_INFO(MSGID_LSCALL_RETRY, 3,
+             PMLOGKS(SERVICE, m_serviceName.c_str()),
+             PMLOGKS("uri", m_uri.c_str()),
+             PMLOGKFV("backoff", "%u", backoff),
+             "");
+
+    m_retrySourceId = g_timeout_add(backoff, cbRetry, this);
+    return true;
+}
+
+void LSCallItem::clearPending()
+{
+    if (m_timeoutSourceId != 0) {
+        g_source_remove(m_timeoutSourceId);
+        m_timeoutSourceId = 0;
+    }
+
+    if (m_retrySourceId != 0) {
+        g_source_remove(m_retrySourceId);
+        m_retrySourceId = 0;
+    }
+
+    if (m_token != 0) {
+        std::string errorText;
+        LSUtils::acquireCaller(m_serviceName).CallCancel(m_token, errorText);
+        m_token = 0;
+        Tracing::end("lscall", m_uri);
+    }
+}
+
 bool LSCallItem::onBeforeCall()
 {
     return true;
@@ -132,19 +226,57 @@ void LSCallItem::setPayload(const char *payload)
       LOG_DEBUG("Invalid payload");
 }
 
-bool LSCallItem::handler(LSHandle *lshandle, LSMessage *message, void *user_data)
+void LSCallItem::onReply(const char *payload, bool hubError)
+{
+    // reply is arrived, nothing to cancel
+    m_token = 0;
+    Tracing::end("lscall", m_uri);
+    if (m_timeoutSourceId != 0) {
+        g_source_remove(m_timeoutSourceId);
+        m_timeoutSourceId = 0;
+    }
+
+    // service is down or not reachable yet, handled as normal reply after retries
+    if (hubError && retry())
+        return;
+
+    pbnjson::JValue json = JUtil::parseTrusted(payload);
+
+    bool result = onReceiveCall(json);
+
+    onFinished(result, getError());
+}
+
+gboolean LSCallItem::cbTimeout(gpointer user_data)
 {
     LSCallItem *call = reinterpret_cast<LSCallItem*>(user_data);
-    if (!call)
-        return false;
+    call->m_timeoutSourceId = 0;
+    call->clearPending();
 
-    pbnjson::JValue json = JUtil::parse(LSMessageGetPayload(message), std::string(""));
+    LOG_WARNING(MSGID_LSCALL_TIMEOUT, 3,
+                PMLOGKS(SERVICE, call->m_serviceName.c_str()),
+                PMLOGKS("uri", call->m_uri.c_str()),
+                PMLOGKFV("tries", "%d", call->m_tries),
+                "");
 
-    bool result = call->onReceiveCall(json);
+    if (call->retry())
+        return G_SOURCE_REMOVE;
 
-    call->onFinished(result, call->getError());
+    call->setError(call->m_uri + " is timed out");
+    call->onFinished(false, call->getError());
+    return G_SOURCE_REMOVE;
+}
 
-    return result;
+gboolean LSCallItem::cbRetry(gpointer user_data)
+{
+    LSCallItem *call = reinterpret_cast<LSCallItem*>(user_data);
+    call->m_retrySourceId = 0;
+
+    std::string errorText;
+    if (!call->send(errorText))
+        call->onError(errorText);
+
+    return G_SOURCE_REMOVE;
 }
 
 CallChain& CallChain::acquire(CallCompleteHandler handler, void *user_data)
@@ -155,7 +287,8 @@ CallChain& CallChain::acquire(CallCompleteHandler handler, void *user_data)
 
 CallChain::CallChain(CallCompleteHandler handler, void *user_data)
     : m_handler(std::move(handler)),
-      m_user_data(user_data)
+      m_user_data(user_data),
+      m_canceled(false)
 {
 }
 
@@ -187,6 +320,14 @@ bool CallChain::run(pbnjson::JValue chainData)
     return proceed(chainData);
 }
 
+void CallChain::cancel()
+{
+    m_canceled = true;
+
+    if (!m_calls.empty() && m_calls.front())
+        m_calls.front()->cancel();
+}
+
 bool CallChain::proceed(pbnjson::JValue chainData)
 {
     if (m_calls.empty()) {
@@ -228,6 +369,11 @@ void CallChain::onCallError(std::string errorText)
 
 void CallChain::onCallFinished(bool result, std::string errorText)
 {
+    if (m_canceled) {
+        finish(makeResult(false, "Cancelled"));
+        return;
+    }
+
     CallItemPtr call = m_calls.front();
     if ((m_calls.size() == 0) || (!call)) {
         finish(makeResult(false, "Callchain broken"));
@@ -272,3 +418,112 @@ void CallChain::onCallFinished(bool result, std::string errorText)
         finish(chainData);
     }
 }
+
+ParallelCallItem::ParallelCallItem(JOIN join)
+    : m_join(join),
+      m_state(std::make_shared<JoinState>(this))
+{
+}
+
+ParallelCallItem::~ParallelCallItem()
+{
+    m_state->owner = nullptr;
+
+    // branches which are not run yet
+    for (CallChain *branch : m_branches)
+        delete branch;
+}
+
+CallChain& ParallelCallItem::addBranch()
+{
+    std::shared_ptr<JoinState> state = m_state;
+    JOIN join = m_join;
+    size_t index = m_branches.size();
+
+    CallChain &branch = CallChain::acquire([state, join, index] (pbnjson::JValue result, void*) {
+        ParallelCallItem::onBranchFinished(state, join, index, result);
+    });
+    m_branches.push_back(&branch);
+    return branch;
+}
+
+size_t ParallelCallItem::getBranchCount() const
+{
+    return m_branches.size();
+}
+
+bool ParallelCallItem::Call()
+{
+    std::vector<CallChain*> branches;
+    branches.swap(m_branches);
+
+    m_state->remain = branches.size();
+    m_state->running = branches;
+    if (branches.empty()) {
+        finish(m_state, true);
+        return true;
+    }
+
+    pbnjson::JValue chainData = getChainData();
+    for (CallChain *branch : branches)
+        branch->run(chainData.duplicate());
+
+    return true;
+}
+
+void ParallelCallItem::cancel()
+{
+    // branches which are not run yet skip their remaining items too
+    for (CallChain *branch : m_branches)
+        branch->cancel();
+
+    // finished branch clears its slot before it's deleted
+    for (size_t i = 0; i < m_state->running.size(); ++i) {
+        if (m_state->running[i])
+            m_state->running[i]->cancel();
+    }
+}
+
+void ParallelCallItem::onBranchFinished(std::shared_ptr<JoinState> state, JOIN join, size_t index, pbnjson::JValue result)
+{
+    if (index < state->running.size())
+        state->running[index] = nullptr;
+
+    --state->remain;
+    if (state->finished)
+        return;
+
+    if (result["returnValue"].asBool()) {
+        ++state->succeeded;
+        if (join == JOIN_ANY) {
+            finish(state, true);
+            return;
+        }
+    } else {
+        std::string errorText = result["errorText"].asString();
+        state->errors.push_back(errorText.empty() ? "unknown error" : errorText);
+    }
+
+    if (state->remain == 0)
+        finish(state, state->errors.empty() || (join == JOIN_ANY && state->succeeded > 0));
+}
+
+void ParallelCallItem::finish(std::shared_ptr<JoinState> state, bool result)
+{
+    state->finished = true;
+
+    std::string errorText;
+    if (!result) {
+        for (const std::string &error : state->errors) {
+            if (!errorText.empty())
+                errorText += "; ";
+            errorText += error;
+        }
+    }
+
+    // branch handler might be called in Call() synchronously
+    Utils::async([state, result, errorText] {
+        if (state->owner)
+            state->owner->onFinished(result, errorText);
+    });
+}
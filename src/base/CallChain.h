@@ -45,12 +45,36 @@ public:
     //! Execute this item
     virtual bool Call() = 0;
 
+    /*! Cancel this item
+     * It's called when chain is canceled while this item is current one.
+     * Item still reports onFinished or onError, default does nothing
+     */
+    virtual void cancel() {}
+
     //! Set option
     void setOption(uint32_t option);
 
     //! Get option
     uint32_t getOption() const;
 
+    //! Set timeout in ms of each try, 0 means no timeout
+    void setTimeout(int timeout);
+
+    //! Get timeout in ms of each try
+    int getTimeout() const;
+
+    /*! Set number of retries after timeout or hub error, default is 0
+     * backoff in ms is doubled on each retry.
+     * Set it only for idempotent queries, the call might have reached the service
+     */
+    void setRetry(int retries, int backoff);
+
+    //! Get number of retries
+    int getRetries() const;
+
+    //! Get backoff in ms before first retry
+    int getRetryBackoff() const;
+
     //! It's called when item is finished
     boost::signals2::signal<void (bool, std::string)> onFinished;
     //! It's called when item has error
@@ -75,6 +99,9 @@ private:
     std::string m_errorText;
     pbnjson::JValue m_chainData;
     uint32_t m_option;
+    int m_timeout;
+    int m_retries;
+    int m_retryBackoff;
 };
 
 //! This class for call item using function
@@ -134,6 +161,9 @@ public:
     //! Constructor
     LSCallItem(const char *serviceName, const char *uri, const char *payload, const char *sessionId = nullptr);
 
+    //! Destructor
+    virtual ~LSCallItem();
+
     //! Execute this item
     virtual bool Call();
 
@@ -151,18 +181,35 @@ protected:
     void setPayload(const char *payload);
 
 private:
+    //! send luna-service call of one try
+    bool send(std::string &errorText);
+    //! schedule next try if retries remain
+    bool retry();
+    //! cancel pending call and its timer
+    void clearPending();
+
     //! handler for luna-service response
-    static bool handler(LSHandle *lshandle, LSMessage *message, void *user_data);
+    void onReply(const char *payload, bool hubError);
+    //! handler for call timeout
+    static gboolean cbTimeout(gpointer user_data);
+    //! handler for retry backoff
+    static gboolean cbRetry(gpointer user_data);
 
 private:
     std::string m_serviceName;
     std::string m_uri;
     std::string m_payload;
     const char *m_sessionId;
+
+    int m_tries;
+    LSMessageToken m_token;
+    guint m_timeoutSourceId;
+    guint m_retrySourceId;
 };
 
 //! This class helps call the items in consecutive order
 class CallChain {
+friend class ParallelCallItem;
     typedef std::shared_ptr<CallItem> CallItemPtr;
     typedef std::function<void (pbnjson::JValue, void*)> CallCompleteHandler;
 
@@ -195,6 +242,13 @@ public:
     //! Run chain
     bool run(pbnjson::JValue chainData = pbnjson::Object());
 
+    /*! Cancel chain
+     * Current item can't be stopped, but remaining items are not called
+     * and handler receives "Cancelled" error when current item is finished.
+     * Current item is canceled too, so ParallelCallItem cancels its branches
+     */
+    void cancel();
+
 private:
     //! Constructor
     CallChain(CallCompleteHandler handler, void *user_data);
@@ -217,6 +271,68 @@ private:
 
     CallCompleteHandler m_handler;
     void *m_user_data;
+    bool m_canceled;
+};
+
+/*! This class runs branch chains at once and finishes when they are joined.
+ * JOIN_ALL finishes when all branches are finished, and fails if any of them fails.
+ * JOIN_ANY finishes when one branch succeeds, and fails only if all of them fail.
+ * Error texts of failed branches are joined into error text of this item
+ */
+class ParallelCallItem : public CallItem {
+public:
+    typedef enum {
+        JOIN_ALL = 0,
+        JOIN_ANY,
+    } JOIN;
+
+    //! Constructor
+    ParallelCallItem(JOIN join = JOIN_ALL);
+
+    //! Destructor
+    virtual ~ParallelCallItem();
+
+    /*! Add new branch chain
+     * Items should be added to returned chain before this item is called
+     */
+    CallChain& addBranch();
+
+    //! Get number of branches
+    size_t getBranchCount() const;
+
+    //! Execute this item
+    virtual bool Call();
+
+    //! Cancel branches, this item fails when they are finished
+    virtual void cancel();
+
+private:
+    //! Join state shared with branch handlers, branches might outlive this item with JOIN_ANY
+    struct JoinState {
+        JoinState(ParallelCallItem *_owner)
+            : owner(_owner),
+              remain(0),
+              succeeded(0),
+              finished(false)
+        {}
+
+        ParallelCallItem *owner;
+        size_t remain;
+        size_t succeeded;
+        bool finished;
+        std::vector<std::string> errors;
+        //! running branches by index, finished one is cleared
+        std::vector<CallChain*> running;
+    };
+
+    //! This is called when one branch is finished
+    static void onBranchFinished(std::shared_ptr<JoinState> state, JOIN join, size_t index, pbnjson::JValue result);
+    //! Finish this item on next loop
+    static void finish(std::shared_ptr<JoinState> state, bool result);
+
+    JOIN m_join;
+    std::vector<CallChain*> m_branches;
+    std::shared_ptr<JoinState> m_state;
 };
 
 #endif
@@ -14,6 +14,10 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <dirent.h>
+#include <errno.h>
+#include <string.h>
+
 #include "JUtil.h"
 #include "Logging.h"
 #include "settings/Settings.h"
@@ -61,6 +65,7 @@ void JUtil::Error::set(ErrorCode code, const char *detail)
 }
 
 JUtil::JUtil()
+    : m_emptySchema(pbnjson::JSchemaFragment("{}"))
 {
 }
 
@@ -70,7 +75,8 @@ JUtil::~JUtil()
 
 pbnjson::JValue JUtil::parse(const char *rawData, const std::string &schemaName, Error *error)
 {
-    pbnjson::JSchema schema = JUtil::instance().loadSchema(schemaName, true);
+    pbnjson::JSchema schema = schemaName.empty() ? JUtil::instance().getEmptySchema()
+                                                 : JUtil::instance().loadSchema(schemaName, true);
     if (!schema.isInitialized()) {
         if (error)
             error->set(Error::Schema);
@@ -106,15 +112,46 @@ pbnjson::JValue JUtil::parseFile(const std::string &path, const std::string &sch
     return parse(rawData.c_str(), schemaName, error);
 }
 
+pbnjson::JValue JUtil::parseTrusted(const char *rawData, Error *error)
+{
+    // AllSchema skips validation, not only accepts everything
+    pbnjson::JInput input(rawData);
+    pbnjson::JDomParser parser;
+    if (!parser.parse(input, pbnjson::JSchema::AllSchema())) {
+        if (error)
+            error->set(Error::Parse, parser.getError());
+
+        return pbnjson::JValue();
+    }
+
+    if (error)
+        error->set(Error::None);
+
+    return parser.getDom();
+}
+
+pbnjson::JValue JUtil::parseFileTrusted(const std::string &path, Error *error)
+{
+    std::string rawData = Utils::read_file(path);
+    if (rawData.empty()) {
+        if (error)
+            error->set(Error::File_Io);
+
+        return pbnjson::JValue();
+    }
+
+    return parseTrusted(rawData.c_str(), error);
+}
+
 std::string JUtil::toSimpleString(pbnjson::JValue json)
 {
-    return pbnjson::JGenerator::serialize(json, pbnjson::JSchemaFragment("{}"));
+    return pbnjson::JGenerator::serialize(json, pbnjson::JSchema::AllSchema());
 }
 
 pbnjson::JSchema JUtil::loadSchema(const std::string& schemaName, bool cache)
 {
     if (schemaName.empty())
-        return pbnjson::JSchemaFragment("{}");
+        return m_emptySchema;
 
     if (cache) {
         std::map<std::string, pbnjson::JSchema>::iterator it = m_mapSchema.find(schemaName);
@@ -123,12 +160,68 @@ pbnjson::JSchema JUtil::loadSchema(const std::string& schemaName, bool cache)
     }
 
     pbnjson::JSchema schema = pbnjson::JSchemaFile(Settings::instance().getSchemaPath() + schemaName + ".schema");
-    if (!schema.isInitialized())
-        return schema;
 
+    // failed one is kept too, so request path doesn't read the file again
     if (cache) {
         m_mapSchema.insert(std::pair< std::string, pbnjson::JSchema >(schemaName, schema));
     }
 
     return schema;
 }
+
+const pbnjson::JSchema& JUtil::getEmptySchema() const
+{
+    return m_emptySchema;
+}
+
+bool JUtil::preloadSchemas(const std::vector<std::string> &required)
+{
+    static const std::string SCHEMA_EXT = ".schema";
+
+    const std::string &schemaPath = Settings::instance().getSchemaPath();
+    DIR *dir = opendir(schemaPath.c_str());
+    if (!dir) {
+        LOG_ERROR(MSGID_SCHEMA_LOAD_FAIL, 2,
+                  PMLOGKS(PATH, schemaPath.c_str()),
+                  PMLOGKS(REASON, strerror(errno)),
+                  "Failed to open schema directory");
+        return false;
+    }
+
+    bool result = true;
+    int loaded = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        std::string fileName = entry->d_name;
+        if (fileName.length() <= SCHEMA_EXT.length() ||
+            fileName.compare(fileName.length() - SCHEMA_EXT.length(), SCHEMA_EXT.length(), SCHEMA_EXT) != 0)
+            continue;
+
+        std::string schemaName = fileName.substr(0, fileName.length() - SCHEMA_EXT.length());
+        if (!loadSchema(schemaName, true).isInitialized()) {
+            LOG_ERROR(MSGID_SCHEMA_LOAD_FAIL, 1,
+                      PMLOGKS(FILENAME, fileName.c_str()),
+                      "Failed to load schema");
+            result = false;
+            continue;
+        }
+        ++loaded;
+    }
+    closedir(dir);
+
+    // missing file is not found by directory walk
+    for (const auto &schemaName : required) {
+        if (!loadSchema(schemaName, true).isInitialized()) {
+            LOG_ERROR(MSGID_SCHEMA_LOAD_FAIL, 1,
+                      PMLOGKS(FILENAME, (schemaName + SCHEMA_EXT).c_str()),
+                      "Failed to load required schema");
+            result = false;
+        }
+    }
+
+    LOG_INFO(MSGID_SCHEMA_PRELOADED, 2,
+             PMLOGKS(PATH, schemaPath.c_str()),
+             PMLOGKFV("count", "%d", loaded),
+             "");
+    return result;
+}
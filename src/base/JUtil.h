@@ -20,6 +20,7 @@
 #include <map>
 #include <pbnjson.hpp>
 #include <string>
+#include <vector>
 
 #include "base/Singleton.hpp"
 
@@ -59,24 +60,42 @@ public:
     };
 
     /*! Parse given json data using schema.
-     * If schemaName is empty, use JSchemaFragment("{}")
+     * If schemaName is empty, use shared empty schema
      */
     static pbnjson::JValue parse(const char *rawData, const std::string &schemaName, Error *error = NULL);
 
     /*! Parse given json file path using schema.
-     * If schemaName is empty, use JSchemaFragment("{}")
+     * If schemaName is empty, use shared empty schema
      */
     static pbnjson::JValue parseFile(const std::string &path, const std::string &schemaName, Error *error = NULL);
 
-    //! Make pbnjson::JValue to std::string
+    /*! Parse given json data without schema validation.
+     * It's for trusted data like luna replies and files written by webOS or appinstalld.
+     */
+    static pbnjson::JValue parseTrusted(const char *rawData, Error *error = NULL);
+
+    //! Parse given json file path without schema validation
+    static pbnjson::JValue parseFileTrusted(const std::string &path, Error *error = NULL);
+
+    //! Make pbnjson::JValue to std::string, it's not validated
     static std::string toSimpleString(pbnjson::JValue json);
 
     /*! Load schema from file.
-     * If schemaName is empty, return JSchemaFragment("{}")
-     * If cache set, find cache first and if not exist in cache load schema and store it.
+     * If schemaName is empty, return shared empty schema
+     * If cache set, find cache first and if not exist in cache load schema and store it
+     * even if it's failed.
      */
     pbnjson::JSchema loadSchema(const std::string &schemaName, bool cache);
 
+    /*! Load all schema files in schema path into cache in one pass.
+     * Failed ones and required ones which can't be loaded are logged and it returns false.
+     * Failures are cached as well, they're not read again on request path.
+     */
+    bool preloadSchemas(const std::vector<std::string> &required);
+
+    //! Get empty schema compiled once and shared by parse and serialize
+    const pbnjson::JSchema& getEmptySchema() const;
+
 protected:
 friend class Singleton<JUtil>;
 
@@ -87,6 +106,7 @@ friend class Singleton<JUtil>;
     ~JUtil();
 
 private:
+    pbnjson::JSchema m_emptySchema;
     std::map< std::string, pbnjson::JSchema > m_mapSchema;
 };
 #endif
@@ -25,8 +25,9 @@
 
 using namespace std::placeholders;
 
-LSCaller::LSCaller(LSHandle *handle)
-    : m_handle(handle)
+LSCaller::LSCaller(LSHandle *handle, LSBus *bus)
+    : m_handle(handle),
+      m_bus(bus)
 {
 }
 
@@ -54,35 +55,48 @@ bool LSCaller::Call(const char *uri,
 bool LSCaller::CallOneReply(const char *uri,
                             const char *payload,
                             const char *sessionId,
-                            LSFilterFunc callback,
-                            void *user_data,
+                            FuncReply onReply,
                             LSMessageToken *ret_token,
                             std::string &errorText,
                             int timeout)
 {
+    LSMessageToken token = 0;
+
+    if (m_bus) {
+        LOG_DEBUG("%s '%s' (bus)", uri, payload);
+        if (!m_bus->call(uri, payload, std::move(onReply), token, errorText))
+            return false;
+
+        if (ret_token)
+            *ret_token = token;
+        return true;
+    }
+
     if (m_handle == NULL) {
         errorText = "LSHandle is NULL";
         return false;
     }
 
     LS::Error lserror;
-    LSMessageToken token = 0;
     if (sessionId) {
         LOG_DEBUG("%s '%s' -c %s", uri, payload, sessionId);
 #if defined(ENABLE_SESSION)
-        if (!LSCallSession(m_handle, uri, payload, sessionId, callback, user_data, &token, lserror)) {
+        if (!LSCallSession(m_handle, uri, payload, sessionId, LSUtils::cbReply, NULL, &token, lserror)) {
             errorText = lserror.what();
             return false;
         }
 #endif
     } else {
         LOG_DEBUG("%s '%s'", uri, payload);
-        if (!LSCallOneReply(m_handle, uri, payload, callback, user_data, &token, lserror)) {
+        if (!LSCallOneReply(m_handle, uri, payload, LSUtils::cbReply, NULL, &token, lserror)) {
             errorText = lserror.what();
             return false;
         }
     }
 
+    // reply is dispatched from main loop, so it can't arrive before it's kept
+    LSUtils::instance().m_pendingReplies[token] = std::move(onReply);
+
     if (timeout != 0) {
         LSCallSetTimeout(m_handle, token, timeout, NULL);
     }
@@ -95,11 +109,17 @@ bool LSCaller::CallOneReply(const char *uri,
 
 bool LSCaller::CallCancel(LSMessageToken token, std::string &errorText)
 {
+    if (m_bus)
+        return m_bus->cancel(token, errorText);
+
     if (m_handle == NULL) {
         errorText = "LSHandle is NULL";
         return false;
     }
 
+    // reply handler is never called for canceled call
+    LSUtils::instance().m_pendingReplies.erase(token);
+
     LS::Error lserror;
     if (!LSCallCancel(m_handle, token, lserror)) {
         errorText = lserror.what();
@@ -111,6 +131,9 @@ bool LSCaller::CallCancel(LSMessageToken token, std::string &errorText)
 
 bool LSCaller::replySubscription(const char *key, const char *payload)
 {
+    if (m_bus)
+        return m_bus->replySubscription(key, payload);
+
     if (!m_handle)
         return false;
 
@@ -123,6 +146,11 @@ bool LSCaller::replySubscription(const char *key, const char *payload)
     return true;
 }
 
+LSUtils::LSUtils()
+    : m_bus(nullptr)
+{
+}
+
 LSCaller LSUtils::acquireCaller(std::string serviceName)
 {
     return LSUtils::instance()._acquireCaller(serviceName);
@@ -164,6 +192,11 @@ bool LSUtils::replyError(Message *LSRequest, int errorCode, std::string errorTex
     return true;
 }
 
+void LSUtils::setBus(LSBus *bus)
+{
+    LSUtils::instance().m_bus = bus;
+}
+
 bool LSUtils::_registerService(ServiceBase *service)
 {
     m_mapService.insert( std::pair<std::string, ServiceBase*>(service->get_service_name(), service) );
@@ -182,6 +215,9 @@ bool LSUtils::_unregisterService(ServiceBase *service)
 
 LSCaller LSUtils::_acquireCaller(std::string serviceName)
 {
+    if (m_bus)
+        return LSCaller(NULL, m_bus);
+
     std::map<std::string, ServiceBase*>::iterator it = m_mapService.find(serviceName);
     if (it == m_mapService.end())
         return LSCaller(NULL);
@@ -189,3 +225,20 @@ LSCaller LSUtils::_acquireCaller(std::string serviceName)
     return LSCaller(it->second->get());
 }
 
+bool LSUtils::cbReply(LSHandle *lshandle, LSMessage *message, void *user_data)
+{
+    std::map<LSMessageToken, LSCaller::FuncReply> &pendingReplies = LSUtils::instance().m_pendingReplies;
+
+    auto it = pendingReplies.find(LSMessageGetResponseToken(message));
+    if (it == pendingReplies.end())
+        return true;
+
+    // handler can make another call, so don't keep iterator while it runs
+    LSCaller::FuncReply onReply = std::move(it->second);
+    pendingReplies.erase(it);
+
+    if (onReply)
+        onReply(LSMessageGetPayload(message), LSMessageIsHubErrorMessage(message));
+
+    return true;
+}
@@ -18,6 +18,7 @@
 #define _LSUTILS_H_
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 #include <luna-service2/lunaservice.hpp>
 #include <map>
@@ -55,10 +56,36 @@ using namespace LS;
 { nullptr, nullptr } \
 };
 
+/*! LSBus class replaces luna-service handle of LSCaller.
+ * It's set to run tasks in process without ls-hubd, e.g. by tests and benchmarks.
+ */
+class LSBus {
+public:
+    //! It's called with reply payload. hubError is set when call isn't delivered by hub
+    typedef std::function<void (const char *payload, bool hubError)> FuncReply;
+
+    virtual ~LSBus() {}
+
+    //! Send call expecting one reply. Reply should be passed to onReply from main loop
+    virtual bool call(const std::string &uri,
+                      const std::string &payload,
+                      FuncReply onReply,
+                      LSMessageToken &token,
+                      std::string &errorText) = 0;
+
+    //! Cancel call, its reply is dropped
+    virtual bool cancel(LSMessageToken token, std::string &errorText) = 0;
+
+    //! Reply message to subscribers of key
+    virtual bool replySubscription(const std::string &key, const std::string &payload) = 0;
+};
+
 class LSCaller {
 public:
+    typedef LSBus::FuncReply FuncReply;
+
     //! Constructor
-    LSCaller(LSHandle *handle);
+    LSCaller(LSHandle *handle, LSBus *bus = nullptr);
 
     //! Call LSCall
     bool Call(const char *uri,
@@ -68,12 +95,11 @@ public:
               LSMessageToken *ret_token,
               std::string &errorText);
 
-    //! Call LSCallOneReply
+    //! Call LSCallOneReply, payload of reply is passed to onReply
     bool CallOneReply(const char *uri,
                       const char *payload,
                       const char *sessionId,
-                      LSFilterFunc callback,
-                      void *user_data,
+                      FuncReply onReply,
                       LSMessageToken *ret_token,
                       std::string &errorText,
                       int timeout = 0);
@@ -88,6 +114,7 @@ public:
 
 private:
     LSHandle *m_handle;
+    LSBus *m_bus;
 };
 
 class ServiceBase;
@@ -95,6 +122,9 @@ class ServiceBase;
 //! List of utilites for luna-service
 class LSUtils : public Singleton<LSUtils> {
 public:
+    //! Constructor
+    LSUtils();
+
     //! Retrieve ServiceHandle for given service name
     static LSCaller acquireCaller(std::string serviceName);
 
@@ -104,8 +134,12 @@ public:
     //! Reply error
     static bool replyError(Message *LSRequest, int errorCode, std::string errorText);
 
+    //! Route calls of all callers to bus instead of registered services. nullptr restores them
+    static void setBus(LSBus *bus);
+
 private:
     friend class ServiceBase;
+    friend class LSCaller;
 
     //! Register service
     bool _registerService(ServiceBase *service);
@@ -116,8 +150,13 @@ private:
     //! Retrieve LSCaller for given service name
     LSCaller _acquireCaller(std::string serviceName);
 
+    //! handler for one reply call, it passes payload to FuncReply kept for the token
+    static bool cbReply(LSHandle *lshandle, LSMessage *message, void *user_data);
+
 private:
     std::map<std::string, ServiceBase*> m_mapService;
+    std::map<LSMessageToken, LSCaller::FuncReply> m_pendingReplies;
+    LSBus *m_bus;
 };
 
 #endif
@@ -47,7 +47,7 @@ std::string Locales::region() const
 
 void Locales::load()
 {
-    pbnjson::JValue info = JUtil::parseFile(Settings::instance().getLocalePath(), std::string(""));
+    pbnjson::JValue info = JUtil::parseFileTrusted(Settings::instance().getLocalePath());
     if (info.isNull())
         return;
 
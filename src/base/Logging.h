@@ -80,6 +80,8 @@
 
 /** AppInstaller.cpp */
 #define MSGID_REPLY_SUBSCR_FAIL         "SUBSCRIBE_FAIL"        /* Reply Subscription Failed */
+#define MSGID_TASK_STARTED              "TASK_STARTED"          /* Task is started after waiting in queue */
+#define MSGID_TASK_PERFORMANCE          "TASK_PERFORMANCE"      /* Step timings of finished task */
 
 /** ServiceInstallerUtility.cpp */
 #define MSGID_WRONG_SERVICEID           "WRONG_SERVICEID"       /* Service id should starts with app id */
@@ -113,6 +115,11 @@
 #define MSGID_JAILER_REMOVE_FAIL        "JAILER_RM_ERR"         /* Removing jailer directory failed */
 #define MSGID_REMOVE_SMACK_FAIL         "REMOVE_SMACK_FAIL"
 
+/** TaskJournal.cpp */
+#define MSGID_JOURNAL_WRITE_FAIL                "JOURNAL_WRITE_FAIL"    /* Writing task journal failed */
+#define MSGID_JOURNAL_RECOVER                   "JOURNAL_RECOVER"       /* Task interrupted at last run is recovered */
+#define MSGID_JOURNAL_DROP                      "JOURNAL_DROP"          /* Task interrupted at last run is not recovered */
+
 /** Task.cpp */
 #define MSGID_TASK_ERROR                        "TASK_ERROR"            /* General error id from task */
 #define MSGID_STATUS_CHANGE_UNDEFINED           "STATUS_UNDEF"          /* next step(status) is not defined */
@@ -148,6 +155,17 @@
 #define MSGID_APPUNPACK_IPK_FAIL         "APPUNPACK_IPK_FAIL"              /* Failed to unpack ipk file */
 #define MSGID_APPUNPACK_TAR_FAIL         "APPUNPACK_TAR_FAIL"              /* Failed to unzip tar file */
 
+/** CallChain.cpp */
+#define MSGID_LSCALL_TIMEOUT             "LSCALL_TIMEOUT"                  /* luna-service call is timed out */
+#define MSGID_LSCALL_RETRY               "LSCALL_RETRY"                    /* luna-service call is retried */
+
+/** CallChainEventHandler.cpp */
+#define MSGID_EXEC_FAIL                  "EXEC_FAIL"                       /* Failed to execute command */
+
+/** JUtil.cpp */
+#define MSGID_SCHEMA_LOAD_FAIL           "SCHEMA_LOAD_FAIL"                /* Failed to load schema file */
+#define MSGID_SCHEMA_PRELOADED           "SCHEMA_PRELOADED"                /* Schema files are loaded at startup */
+
 /** Settings.cpp */
 #define MSGID_SETTINGS_PARSE_FAIL        "SETTINGS_PARSE_FAIL" /** Failed to parse file */
 
@@ -0,0 +1,69 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <map>
+
+#include "Tracing.h"
+#include "Logging.h"
+
+#if defined(PMTRACE_BEFORE) && defined(PMTRACE_AFTER)
+#define TRACING_ENABLED
+#endif
+
+#if defined(TRACING_ENABLED)
+static std::string makeLabel(const char *label, const std::string &key)
+{
+    return key.empty() ? std::string(label) : std::string(label) + " " + key;
+}
+
+//! label of span for each running child process
+static std::map<GPid, std::string> s_children;
+#endif
+
+void Tracing::begin(const char *label, const std::string &key)
+{
+#if defined(TRACING_ENABLED)
+    PMTRACE_BEFORE(makeLabel(label, key).c_str());
+#endif
+}
+
+void Tracing::end(const char *label, const std::string &key)
+{
+#if defined(TRACING_ENABLED)
+    PMTRACE_AFTER(makeLabel(label, key).c_str());
+#endif
+}
+
+void Tracing::childStarted(GPid pid, const char *label, const std::string &key)
+{
+#if defined(TRACING_ENABLED)
+    std::string traceLabel = makeLabel(label, key);
+    PMTRACE_BEFORE(traceLabel.c_str());
+    s_children[pid] = std::move(traceLabel);
+#endif
+}
+
+void Tracing::childExited(GPid pid)
+{
+#if defined(TRACING_ENABLED)
+    auto it = s_children.find(pid);
+    if (it == s_children.end())
+        return;
+
+    PMTRACE_AFTER(it->second.c_str());
+    s_children.erase(it);
+#endif
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <glib.h>
+#include <string>
+
+/*! Tracing class emits PmTrace spans keyed by appId or other subject.
+ * Span is a pair of before/after trace points labeled "label key",
+ * so spans of concurrent tasks are told apart in LTTng timelines.
+ * All of them are no-op when PmTrace doesn't provide trace points.
+ */
+class Tracing {
+public:
+    //! Span which lasts until end of scope
+    class Span {
+    public:
+        Span(const char *label, const std::string &key)
+            : m_label(label), m_key(key)
+        {
+            Tracing::begin(m_label, m_key);
+        }
+
+        ~Span()
+        {
+            Tracing::end(m_label, m_key);
+        }
+
+    private:
+        const char *m_label;
+        std::string m_key;
+    };
+
+    //! Begin span
+    static void begin(const char *label, const std::string &key);
+
+    //! End span
+    static void end(const char *label, const std::string &key);
+
+    //! Begin span of child process, it's ended by childExited
+    static void childStarted(GPid pid, const char *label, const std::string &key);
+
+    //! End span of child process
+    static void childExited(GPid pid);
+};
+
+#endif
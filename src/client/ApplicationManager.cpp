@@ -31,9 +31,8 @@ ApplicationManager::~ApplicationManager()
 {
 }
 
-bool ApplicationManager::onLockApp(LSHandle* sh, LSMessage* reply, void* ctx)
+void ApplicationManager::onLockApp(const char* payload, bool hubError)
 {
-    return true;
 }
 
 bool ApplicationManager::lockApp(const char* sessionId, const string& id, bool lock)
@@ -46,7 +45,7 @@ bool ApplicationManager::lockApp(const char* sessionId, const string& id, bool l
 
     std::string errorText;
     LSCaller caller = LSUtils::acquireCaller("com.webos.appInstallService");
-    if (!caller.CallOneReply(API.c_str(), requestPayload.stringify().c_str(), sessionId, onLockApp, this, nullptr, errorText)) {
+    if (!caller.CallOneReply(API.c_str(), requestPayload.stringify().c_str(), sessionId, onLockApp, nullptr, errorText)) {
         Logger::error(getClassName(), __FUNCTION__, "lockApp error: " + errorText);
         return false;
     }
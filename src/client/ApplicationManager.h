@@ -44,7 +44,7 @@ protected:
     virtual void onServerStatusChanged(bool isConnected) override;
 
 private:
-    static bool onLockApp(LSHandle* sh, LSMessage* reply, void* ctx);
+    static void onLockApp(const char* payload, bool hubError);
 
     ApplicationManager();
 };
@@ -131,7 +131,7 @@ pbnjson::JValue AppInfo::getRequiredPermissions() const
 bool AppInfo::load()
 {
     std::string path = m_appPath + "/appinfo.json";
-    m_info = JUtil::parseFile(path, std::string(""));
+    m_info = JUtil::parseFileTrusted(path);
 
     if (m_info.isNull())
         return false;
@@ -150,15 +150,15 @@ bool AppInfo::loadLocalization()
     std::string regionPath = m_appPath + "/resources/" + language + "/" + region;
     std::string scriptPath = m_appPath + "/resources/" + language + "/" + script + "/" + region;
 
-    m_info_localize[LOCALIZE_LANGUAGE] = JUtil::parseFile(languagePath + "/appinfo.json", std::string(""));
+    m_info_localize[LOCALIZE_LANGUAGE] = JUtil::parseFileTrusted(languagePath + "/appinfo.json");
     if (!m_info_localize[LOCALIZE_LANGUAGE].isNull())
         m_info_localize[LOCALIZE_LANGUAGE].put(KEY_APPBASE, languagePath);
 
-    m_info_localize[LOCALIZE_REGION] = JUtil::parseFile(regionPath + "/appinfo.json", std::string(""));
+    m_info_localize[LOCALIZE_REGION] = JUtil::parseFileTrusted(regionPath + "/appinfo.json");
     if (!m_info_localize[LOCALIZE_REGION].isNull())
         m_info_localize[LOCALIZE_REGION].put(KEY_APPBASE, regionPath);
 
-    m_info_localize[LOCALIZE_SCRIPT] = JUtil::parseFile(scriptPath + "/appinfo.json", std::string(""));
+    m_info_localize[LOCALIZE_SCRIPT] = JUtil::parseFileTrusted(scriptPath + "/appinfo.json");
     if (!m_info_localize[LOCALIZE_SCRIPT].isNull())
         m_info_localize[LOCALIZE_SCRIPT].put(KEY_APPBASE, scriptPath);
 
@@ -16,6 +16,7 @@
 
 
 #include <algorithm>
+#include <cinttypes>
 #include <functional>
 
 #include "AppInstaller.h"
@@ -24,16 +25,26 @@
 #include "base/Utils.h"
 #include "base/Logging.h"
 #include "installer/AppInstallerErrors.h"
+#include "installer/AppInstallerUtility.h"
 #include "installer/Task.h"
+#include "installer/TaskHistory.h"
 #include "settings/Settings.h"
 #include "settings/StepSettings.h"
 
 using namespace std::placeholders;
 
 AppInstaller::AppInstaller()
-    : m_installerDataPath(Settings::instance().getInstallerDataPath())
+    : m_flushScheduled(false),
+      m_lastBatchId(0)
 {
+    Settings::instance().loadConfigure();
     StepSettings::instance().loadStepConfigure();
+
+    // it can be changed by conf
+    m_installerDataPath = Settings::instance().getInstallerDataPath();
+
+    // canceled opkg child holds lock until it's reaped
+    AppInstallerUtility::signalIdle.connect(std::bind(&AppInstaller::grantOpkg, this));
 }
 
 AppInstaller::~AppInstaller()
@@ -43,11 +54,164 @@ AppInstaller::~AppInstaller()
 
 bool AppInstaller::initialize()
 {
+    std::vector<TaskJournal::Record> unfinished;
+    if (!TaskJournal::instance().open(m_installerDataPath + "/taskjournal", unfinished))
+        return false;
+
+    for (const auto &record : unfinished)
+        recoverTask(record);
+
     return true;
 }
 
+void AppInstaller::recoverTask(const TaskJournal::Record &record)
+{
+    pbnjson::JValue param = record.param;
+    std::string name = param["name"].asString();
+    std::string appId = param["id"].asString();
+    bool verify = param["verify"].asBool();
+    int checkpoint = record.checkpoint.isNull() ? Unknown : record.checkpoint["step"].asNumber<int>();
+
+    LOG_INFO(MSGID_JOURNAL_RECOVER, 4,
+             PMLOGKS(APP_ID, appId.c_str()),
+             PMLOGKS("task", name.c_str()),
+             PMLOGKFV(STATUS, "%d", record.lastStep),
+             PMLOGKFV("checkpoint", "%d", checkpoint),
+             "");
+
+    if (name == "InstallTask") {
+        if (record.lastStep == InstallComplete) {
+            dropRecord(record, "install is completed");
+            return;
+        }
+
+        std::string ipkUrl = param["ipkurl"].asString();
+        std::string ipkPath = Utils::isPWA(ipkUrl) ? Utils::getPWAPath(ipkUrl) : ipkUrl;
+        bool failed = (record.lastStep == ErrorInstall || record.lastStep == InstallCanceled);
+
+        if (failed) {
+            // failure is already told to client, undo files opkg might have written
+            if (record.opkgStarted)
+                rollbackInstall(appId, verify);
+            else
+                dropRecord(record, "install has failed before opkg");
+        } else if (record.opkgCompleted) {
+            // package is in place, later steps don't need ipk anymore
+            resumeTask(record, record.checkpoint);
+        } else if (!Utils::is_File_exist(ipkPath)) {
+            if (record.opkgStarted)
+                rollbackInstall(appId, verify);
+            else
+                dropRecord(record, "ipk is not found");
+        } else if (record.opkgStarted && !record.checkpoint.isNull()) {
+            // opkg is interrupted, same version should be installed again over broken one
+            pbnjson::JValue reinstall = record.checkpoint.duplicate();
+            reinstall.put("allowReInstall", true);
+            resumeTask(record, std::move(reinstall));
+        } else {
+            resumeTask(record, record.checkpoint);
+        }
+    } else if (name == "RemoveTask") {
+        if (record.lastStep == RemoveComplete) {
+            dropRecord(record, "remove is completed");
+            return;
+        }
+
+        // error step is journaled before its status is published, client knows the result
+        // steps shared with install might report error as ErrorInstall
+        if (record.lastStep == ErrorRemove || record.lastStep == ErrorInstall) {
+            dropRecord(record, "remove has failed");
+            return;
+        }
+
+        // interrupted step is the one after checkpoint, so it's tried again
+        resumeTask(record, record.checkpoint);
+    } else {
+        dropRecord(record, "unknown task");
+    }
+}
+
+void AppInstaller::dropRecord(const TaskJournal::Record &record, const char *reason)
+{
+    LOG_INFO(MSGID_JOURNAL_DROP, 4,
+             PMLOGKS(APP_ID, record.param["id"].asString().c_str()),
+             PMLOGKS("task", record.param["name"].asString().c_str()),
+             PMLOGKFV(STATUS, "%d", record.lastStep),
+             PMLOGKS("reason", reason),
+             "");
+}
+
+void AppInstaller::resumeTask(const TaskJournal::Record &record, pbnjson::JValue checkpoint)
+{
+    pbnjson::JValue param = record.param;
+    std::string name = param["name"].asString();
+    std::string appId = param["id"].asString();
+    bool verify = param["verify"].asBool();
+
+    int errorCode = 0;
+    std::string errorText;
+
+    // nothing is completed, start over
+    if (checkpoint.isNull()) {
+        std::shared_ptr<Task> task;
+        if (name == "InstallTask")
+            task = install(appId, param["ipkurl"].asString(), param["appinfo"], errorCode, errorText, verify, param["downgrade"].asBool());
+        else
+            task = remove(appId, param["appinfo"], errorCode, errorText, verify);
+
+        if (!task)
+            dropRecord(record, errorText.c_str());
+        return;
+    }
+
+    // e.g. rollback of other record of same app is already scheduled
+    if (isAppKnown(appId)) {
+        dropRecord(record, "other task of the app is running");
+        return;
+    }
+
+    auto task = createTask(appId, name, param);
+    if (!task) {
+        dropRecord(record, "unable to create task");
+        return;
+    }
+
+    task->resume(std::move(checkpoint));
+    if (task->getPackageId().empty())
+        task->setPackageId(appId);
+
+    // journal again what last run has done, task can be recovered same way if it's interrupted again
+    TaskJournal::instance().step(appId, record.lastStep);
+    TaskJournal::instance().checkpoint(appId, task->getCheckpoint());
+
+    scheduleTask(task);
+}
+
+void AppInstaller::rollbackInstall(const std::string &appId, bool verify)
+{
+    pbnjson::JValue appInfo = pbnjson::Object();
+    pbnjson::JValue details = pbnjson::Object();
+
+    details.put("client", "com.webos.appInstallService");
+    appInfo.put("id", appId);
+    appInfo.put("details", details);
+
+    int errorCode = 0;
+    std::string errorText;
+    remove(appId, appInfo, errorCode, errorText, verify);
+}
+
 void AppInstaller::finalize()
 {
+    TaskJournal::instance().close();
+    m_queuedTasks.clear();
+    m_runningTasks.clear();
+    m_opkgWaiters.clear();
+    m_opkgOwner.clear();
+    m_dirtyTasks.clear();
+    m_dirtyBatches.clear();
+    m_batchOfApp.clear();
+    m_batches.clear();
     m_mapTask.clear();
 }
 
@@ -80,7 +244,7 @@ std::shared_ptr<Task> AppInstaller::install(const std::string& appId,
             return nullptr;
         }
 
-        task->run();
+        scheduleTask(task);
         return task;
     } else {
         errorCode = APP_INSTALL_ERR_INSTALL;
@@ -90,6 +254,72 @@ std::shared_ptr<Task> AppInstaller::install(const std::string& appId,
     return nullptr;
 }
 
+std::string AppInstaller::installBatch(pbnjson::JValue packages,
+                                      const std::string &client,
+                                      int &errorCode,
+                                      std::string &errorText)
+{
+    // validate all of packages before installing any of them
+    std::set<std::string> appIds;
+    for (int i = 0; i < packages.arraySize(); ++i) {
+        std::string appId = packages[i]["id"].asString();
+
+        if (!appIds.insert(appId).second) {
+            errorCode = APP_INSTALL_ERR_DUPLICATED;
+            errorText = appId + " is requested more than once";
+            return "";
+        }
+
+        if (isAppKnown(appId)) {
+            errorCode = APP_INSTALL_ERR_DUPLICATED;
+            errorText = appId + " has a command which has not completed";
+            return "";
+        }
+    }
+
+    std::string batchId = std::to_string(++m_lastBatchId);
+    Batch &batch = m_batches[batchId];
+
+    for (int i = 0; i < packages.arraySize(); ++i) {
+        std::string appId = packages[i]["id"].asString();
+        std::string ipkUrl = packages[i]["ipkUrl"].asString();
+
+        pbnjson::JValue details = packages[i].duplicate();
+        details.put("client", client);
+        details.put("batchId", batchId);
+
+        pbnjson::JValue appInfo = pbnjson::Object();
+        appInfo.put("id", appId);
+        appInfo.put("details", details);
+
+        batch.appIds.push_back(appId);
+        batch.status[appId] = appInfo.duplicate();
+
+        int installErrorCode = 0;
+        std::string installErrorText;
+        if (!install(appId, ipkUrl, appInfo, installErrorCode, installErrorText)) {
+            pbnjson::JValue status = batch.status[appId];
+            status["details"].put("state", "install failed");
+            status["details"].put("errorCode", installErrorCode);
+            status["details"].put("reason", installErrorText);
+            ++batch.failed;
+
+            errorCode = installErrorCode;
+            errorText = installErrorText;
+            continue;
+        }
+
+        m_batchOfApp[appId] = batchId;
+    }
+
+    if (batch.failed == (int) batch.appIds.size()) {
+        m_batches.erase(batchId);
+        return "";
+    }
+
+    return batchId;
+}
+
 std::shared_ptr<Task> AppInstaller::remove(const std::string& appId,
                                            pbnjson::JValue appInfo,
                                            int& errorCode,
@@ -115,7 +345,7 @@ std::shared_ptr<Task> AppInstaller::remove(const std::string& appId,
         }
 
         task->setPackageId(appId);
-        task->run();
+        scheduleTask(task);
         return task;
     } else {
         errorCode = APP_REMOVE_ERR_REMOVE;
@@ -125,22 +355,93 @@ std::shared_ptr<Task> AppInstaller::remove(const std::string& appId,
     return nullptr;
 }
 
+bool AppInstaller::cancel(const std::string &appId, int &errorCode, std::string &errorText)
+{
+    std::shared_ptr<Task> task = get(appId);
+    if (!task || task->getName() != "InstallTask") {
+        errorCode = APP_INSTALL_ERR_GENERAL;
+        errorText = "no install task for the app";
+        return false;
+    }
+
+    if (!task->cancel()) {
+        errorCode = APP_INSTALL_ERR_GENERAL;
+        errorText = "install task is already finished or being canceled";
+        return false;
+    }
+
+    // running slot is freed by onFinishTask, current step might still run until then
+    return true;
+}
+
 void AppInstaller::onStartTask(const Task &task)
 {
-    //TODO : writePerformanceLog
+    LOG_INFO(MSGID_TASK_STARTED, 3,
+             PMLOGKS(APP_ID, task.getAppId().c_str()),
+             PMLOGKS(TASK_NAME, task.getName().c_str()),
+             PMLOGKFV("waitTime", "%" PRId64, (task.getRunTime() - task.getCreatedTime()) / 1000),
+             "");
 }
 
 void AppInstaller::onUpdateTask(const Task &task)
 {
-    pbnjson::JValue json = task.toJValue();
+    // error is synced before its status goes out, so recovery doesn't run reported task again
+    TaskJournal::instance().step(task.getAppId(), task.getStep(), task.isError());
+    if (task.isCheckpoint())
+        TaskJournal::instance().checkpoint(task.getAppId(), task.getCheckpoint());
+
+    auto it = m_mapTask.find(task.getAppId());
+    if (it == m_mapTask.end() || it->second.get() != &task) {
+        // not managed task, nothing to coalesce with
+        publishStatus(task);
+        return;
+    }
+
+    // only latest status is published, intermediate ones are dropped
+    if (std::find(m_dirtyTasks.begin(), m_dirtyTasks.end(), it->second) == m_dirtyTasks.end())
+        m_dirtyTasks.push_back(it->second);
+
+    if (m_flushScheduled)
+        return;
+
+    m_flushScheduled = true;
+    Utils::async([this] {
+        m_flushScheduled = false;
+        flushStatus();
+    }, Settings::instance().getStatusInterval());
+}
+
+void AppInstaller::flushStatus()
+{
+    std::vector<std::shared_ptr<Task> > tasks;
+    tasks.swap(m_dirtyTasks);
+
+    for (const auto &task : tasks)
+        publishStatus(*task);
 
-    if (json.isNull()) {
+    std::set<std::string> batches;
+    batches.swap(m_dirtyBatches);
+
+    for (const auto &batchId : batches)
+        publishBatch(batchId);
+}
+
+void AppInstaller::publishStatus(const Task &task)
+{
+    const std::string &payload = task.getStatusString();
+
+    if (payload.empty()) {
         return;
     }
 
+    auto batch = m_batchOfApp.find(task.getAppId());
+    if (batch != m_batchOfApp.end()) {
+        m_batches[batch->second].status[task.getAppId()] = task.toJValue();
+        m_dirtyBatches.insert(batch->second);
+    }
+
     LSCaller caller = LSUtils::acquireCaller("com.webos.appInstallService");
     std::string key = std::string("status_") + task.getAppId();
-    std::string payload = JUtil::toSimpleString(std::move(json));
     if (!caller.replySubscription(key.c_str(), payload.c_str())) {
         LOG_WARNING(MSGID_REPLY_SUBSCR_FAIL, 2,
                     PMLOGKS(KEY,key.c_str()),
@@ -153,12 +454,78 @@ void AppInstaller::onUpdateTask(const Task &task)
     }
 }
 
+void AppInstaller::publishBatch(const std::string &batchId)
+{
+    auto it = m_batches.find(batchId);
+    if (it == m_batches.end())
+        return;
+
+    const Batch &batch = it->second;
+    pbnjson::JValue packages = pbnjson::Array();
+    for (const auto &appId : batch.appIds)
+        packages.append(batch.status.at(appId));
+
+    pbnjson::JValue json = pbnjson::Object();
+    json.put("batchId", batchId);
+    json.put("total", (int) batch.appIds.size());
+    json.put("completed", batch.completed);
+    json.put("failed", batch.failed);
+    json.put("packages", packages);
+
+    LSCaller caller = LSUtils::acquireCaller("com.webos.appInstallService");
+    std::string key = std::string("batch_") + batchId;
+    std::string payload = JUtil::toSimpleString(std::move(json));
+    if (!caller.replySubscription(key.c_str(), payload.c_str())) {
+        LOG_WARNING(MSGID_REPLY_SUBSCR_FAIL, 2,
+                    PMLOGKS(KEY,key.c_str()),
+                    PMLOGKS(PAYLOAD,payload.c_str()),
+                    "reply subscription failed");
+    }
+}
+
 void AppInstaller::onFinishTask(const Task &task)
 {
+    TaskJournal::instance().end(task.getAppId());
+    TaskHistory::instance().add(task);
+    writePerformanceLog(task);
+
+    std::string batchId;
+    auto batch = m_batchOfApp.find(task.getAppId());
+    if (batch != m_batchOfApp.end() && task.getName() == "InstallTask") {
+        batchId = batch->second;
+        m_batchOfApp.erase(batch);
+
+        Batch &current = m_batches[batchId];
+        if (task.isError())
+            ++current.failed;
+        else
+            ++current.completed;
+        current.status[task.getAppId()] = task.toJValue();
+        m_dirtyBatches.insert(batchId);
+    }
+
+    // terminal status should be delivered before task is released
+    flushStatus();
+
+    if (!batchId.empty()) {
+        const Batch &current = m_batches[batchId];
+        if (current.completed + current.failed == (int) current.appIds.size())
+            m_batches.erase(batchId);
+    }
+
     signalFinished(task);
 
     std::string id = task.getAppId();
 
+    // free opkg and running slot so that next tasks can go on
+    releaseOpkg(id);
+    m_runningTasks.erase(&task);
+    m_queuedTasks.erase(std::remove_if(m_queuedTasks.begin(),
+                                       m_queuedTasks.end(),
+                                       [&task] (const std::shared_ptr<Task> &v) -> bool { return v.get() == &task; }),
+                        m_queuedTasks.end());
+    runQueuedTasks();
+
     Utils::async([=] {
         releaseTask(id);
     });
@@ -200,6 +567,74 @@ bool AppInstaller::releaseTask(const std::string appId) {
     return true;
 }
 
+void AppInstaller::scheduleTask(std::shared_ptr<Task> task)
+{
+    m_queuedTasks.push_back(std::move(task));
+    runQueuedTasks();
+}
+
+void AppInstaller::runQueuedTasks()
+{
+    size_t maxTasks = Settings::instance().getMaxConcurrentTasks();
+
+    while (!m_queuedTasks.empty() && m_runningTasks.size() < maxTasks) {
+        std::shared_ptr<Task> task = m_queuedTasks.front();
+        m_queuedTasks.pop_front();
+
+        LOG_DEBUG("[AppInstaller]::runQueuedTasks: run %s (%zu running, %zu queued)\n",
+                  task->getAppId().c_str(), m_runningTasks.size() + 1, m_queuedTasks.size());
+
+        m_runningTasks.insert(task.get());
+        task->run();
+    }
+}
+
+void AppInstaller::acquireOpkg(const std::string &appId, std::function<void ()> onAcquired)
+{
+    if (!m_opkgOwner.empty())
+        LOG_DEBUG("[AppInstaller]::acquireOpkg: %s waits for opkg used by %s\n",
+                  appId.c_str(), m_opkgOwner.c_str());
+
+    // even free opkg is granted from main loop, caller can't be re-entered from acquireOpkg
+    m_opkgWaiters.push_back(std::make_pair(appId, std::move(onAcquired)));
+    grantOpkg();
+}
+
+void AppInstaller::releaseOpkg(const std::string &appId)
+{
+    m_opkgWaiters.erase(std::remove_if(m_opkgWaiters.begin(),
+                                       m_opkgWaiters.end(),
+                                       [&appId] (const std::pair<std::string, std::function<void ()> > &v) -> bool { return v.first == appId; }),
+                        m_opkgWaiters.end());
+
+    if (m_opkgOwner != appId)
+        return;
+
+    m_opkgOwner.clear();
+    grantOpkg();
+}
+
+void AppInstaller::grantOpkg()
+{
+    if (!m_opkgOwner.empty() || m_opkgWaiters.empty())
+        return;
+
+    // it's granted again when canceled child is reaped
+    if (AppInstallerUtility::isBusy())
+        return;
+
+    m_opkgOwner = m_opkgWaiters.front().first;
+    std::function<void ()> onAcquired = std::move(m_opkgWaiters.front().second);
+    m_opkgWaiters.pop_front();
+
+    // grant it on next loop, current owner might be still in its callback
+    std::string owner = m_opkgOwner;
+    Utils::async([=] {
+        if (m_opkgOwner == owner)
+            onAcquired();
+    });
+}
+
 std::shared_ptr<Task> AppInstaller::createTask(const std::string &id, const std::string &name, pbnjson::JValue param) {
 
     std::shared_ptr<Task> task = std::make_shared<Task>();
@@ -208,9 +643,10 @@ std::shared_ptr<Task> AppInstaller::createTask(const std::string &id, const std:
     task->initialize(param);
 
     if (name == "InstallTask") {
-        task->prepareStep(StepSettings::instance().m_mapInstallSteps);
+        StepSettings::TaskType type = task->isPWA() ? StepSettings::PWAInstallType : StepSettings::IpkInstallType;
+        task->prepareStep(&StepSettings::instance().getRegistry(type));
     } else if (name == "RemoveTask") {
-        task->prepareStep(StepSettings::instance().m_mapRemoveSteps);
+        task->prepareStep(&StepSettings::instance().getRegistry(StepSettings::RemoveType));
     } else {
         return nullptr;
     }
@@ -220,6 +656,7 @@ std::shared_ptr<Task> AppInstaller::createTask(const std::string &id, const std:
     task->signalFinished.connect(std::bind(&AppInstaller::onFinishTask, this, _1));
 
     m_mapTask[id] = task;
+    TaskJournal::instance().begin(id, param);
 
     return task;
 }
@@ -246,15 +683,42 @@ std::shared_ptr<Task> AppInstaller::get(const std::string &appId) {
     return it->second;
 }
 
-pbnjson::JValue AppInstaller::toJValue() const {
-    pbnjson::JValue array = pbnjson::Array();
+void AppInstaller::writePerformanceLog(const Task &task)
+{
+    const TaskHistory::Record *record = TaskHistory::instance().getLastRecord();
+    if (!record || record->appId != task.getAppId())
+        return;
+
+    // "step:ms" of each step in order they're passed
+    std::string steps;
+    for (const auto &step : record->steps) {
+        if (!steps.empty())
+            steps += " ";
+        steps += TaskStepParser::enumToStringStep(step.first) + ":" + std::to_string(step.second);
+    }
+
+    LOG_INFO(MSGID_TASK_PERFORMANCE, 5,
+             PMLOGKS(APP_ID, record->appId.c_str()),
+             PMLOGKS(TASK_NAME, record->name.c_str()),
+             PMLOGKFV("waitTime", "%" PRId64, record->waitTime),
+             PMLOGKFV("runTime", "%" PRId64, record->runTime),
+             PMLOGKS("steps", steps.c_str()),
+             "");
+}
+
+std::string AppInstaller::getStatusString() const {
+    std::string array = "[";
 
-    std::for_each(m_mapTask.begin(),
-                  m_mapTask.end(),
-                  [&array] (const std::pair<std::string, std::shared_ptr<Task> > v) -> void {
-                      pbnjson::JValue json = v.second->toJValue();
-                      array.append(json);
-                  });
+    for (const auto &v : m_mapTask) {
+        const std::string &status = v.second->getStatusString();
+        if (status.empty())
+            continue;
+
+        if (array.size() > 1)
+            array += ",";
+        array += status;
+    }
 
+    array += "]";
     return array;
 }
@@ -17,14 +17,19 @@
 #ifndef APP_INSTALLER_H
 #define APP_INSTALLER_H
 
+#include <deque>
+#include <functional>
 #include <map>
 #include <memory>
 #include <pbnjson.hpp>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "base/Singleton.hpp"
 #include "InstallHistory.h"
 #include "Task.h"
+#include "TaskJournal.h"
 
 class Task;
 
@@ -39,7 +44,7 @@ public:
     //! Destructor
     ~AppInstaller();
 
-    //! open db file & initialize install map from db
+    //! open task journal & recover tasks interrupted at last run
     bool initialize();
 
     //! clear install map
@@ -55,6 +60,16 @@ public:
                                   bool allowDowngrade = true,
                                   std::string taskName = "InstallTask");
 
+    /*! Install apps of given packages at once
+     * packages is array of { "id", "ipkUrl" }. All packages are validated before any is installed.
+     * Tasks are scheduled together, so their steps run in parallel except opkg phase.
+     * It returns batch id, aggregate status is published to "batch_<batch id>" subscription.
+     */
+    std::string installBatch(pbnjson::JValue packages,
+                             const std::string &client,
+                             int &errorCode,
+                             std::string &errorText);
+
     //! Remove app from given appId
     std::shared_ptr<Task> remove(const std::string &appId,
                                  pbnjson::JValue appInfo,
@@ -62,9 +77,22 @@ public:
                                  std::string& errorText,
                                  bool verify = true);
 
+    //! Cancel install task of given appId
+    bool cancel(const std::string &appId, int &errorCode, std::string &errorText);
+
     //! Check contains task instance
     bool contains(Task *task);
 
+    /*! Request exclusive access to opkg for given appId.
+     * opkg can handle only one command at once, so only one task enters
+     * the opkg phase at a time. onAcquired is called from main loop when access
+     * is granted, on next iteration if opkg is free, or after current owner releases it.
+     */
+    void acquireOpkg(const std::string &appId, std::function<void ()> onAcquired);
+
+    //! Release opkg access or pending request of given appId
+    void releaseOpkg(const std::string &appId);
+
     //! Get task instance
     std::shared_ptr<Task> get(const std::string &appId);
 
@@ -82,8 +110,10 @@ public:
         return static_cast<T>(task);
     }
 
-    //! to pbnjson::JValue
-    pbnjson::JValue toJValue() const;
+    /*! get status of all tasks as serialized json array
+     * It's concatenation of status cached by each task
+     */
+    std::string getStatusString() const;
 
     //! signal for notify started
     boost::signals2::signal<void (const Task&)> signalStarted;
@@ -101,22 +131,92 @@ protected:
     //! It's called when Task finished
     void onFinishTask(const Task &task);
 
+    //! publish status of tasks changed since last flush
+    void flushStatus();
+
+    //! reply status of task to subscribers of app and global status
+    void publishStatus(const Task &task);
+
+    //! reply aggregate status of batch to its subscribers
+    void publishBatch(const std::string &batchId);
+
     //! It's called when DB read row
     //! check whether appId is known
     bool isAppKnown(const std::string& appId);
 
+    /*! recover task interrupted at last run
+     * Task is resumed from its last checkpoint, the step after it is run again.
+     * Interrupted opkg is run again with reinstall if ipk is still there, otherwise
+     * files which opkg might have written are removed. Install which has failed
+     * after opkg is started is rolled back in same way. Task whose terminal status
+     * might have been published is not run again.
+     */
+    void recoverTask(const TaskJournal::Record &record);
+
+    //! log record of last run which is not recovered and why
+    void dropRecord(const TaskJournal::Record &record, const char *reason);
+
+    //! create task of record and resume it from checkpoint, start over if checkpoint is null
+    void resumeTask(const TaskJournal::Record &record, pbnjson::JValue checkpoint);
+
+    //! remove package which interrupted or failed install might have left
+    void rollbackInstall(const std::string &appId, bool verify);
+
     //! create task from name with param
     std::shared_ptr<Task> createTask(const std::string &id, const std::string &name, pbnjson::JValue param);
 
     //! release accuired task
     bool releaseTask(const std::string appId);
 
+    //! queue task and run it when there is a free slot
+    void scheduleTask(std::shared_ptr<Task> task);
+
+    //! run queued tasks as long as running tasks are less than limit
+    void runQueuedTasks();
+
+    //! grant opkg to first waiter if nobody uses it
+    void grantOpkg();
+
+    //! write summary of step timings of finished task
     void writePerformanceLog(const Task &task);
 
 private:
     std::string m_installerDataPath;
 
     std::map<std::string, std::shared_ptr<Task> > m_mapTask;
+
+    //! tasks waiting for free slot, in requested order
+    std::deque<std::shared_ptr<Task> > m_queuedTasks;
+    //! tasks currently running
+    std::set<const Task*> m_runningTasks;
+
+    //! appId of task which is using opkg
+    std::string m_opkgOwner;
+    //! tasks waiting for opkg, in requested order
+    std::deque<std::pair<std::string, std::function<void ()> > > m_opkgWaiters;
+
+    //! tasks whose status changed since last flush, in changed order
+    std::vector<std::shared_ptr<Task> > m_dirtyTasks;
+    bool m_flushScheduled;
+
+    //! install tasks requested by installBatch
+    struct Batch {
+        Batch() : completed(0), failed(0) {}
+
+        //! appIds in requested order
+        std::vector<std::string> appIds;
+        //! last status of each app
+        std::map<std::string, pbnjson::JValue> status;
+        int completed;
+        int failed;
+    };
+
+    unsigned int m_lastBatchId;
+    std::map<std::string, Batch> m_batches;
+    //! appId to batch id
+    std::map<std::string, std::string> m_batchOfApp;
+    //! batches whose status changed since last flush
+    std::set<std::string> m_dirtyBatches;
 };
 
 #endif
@@ -40,6 +40,7 @@ enum {
     APP_INSTALL_ERR_TARGETISBUSY    = -18, // The USB is busy
     APP_REMOVE_ERR_PRIVILEGED       = -19,
     APP_INSTALL_ERR_SMACK           = -20,
+    APP_INSTALL_ERR_CANCELED        = -21, // Install is canceled by request
 };
 
 #endif
@@ -21,11 +21,12 @@
 #include "AppInstallerUtility.h"
 #include "base/Logging.h"
 #include "base/System.h"
+#include "base/Tracing.h"
 #include "base/Utils.h"
 #include "settings/Settings.h"
-#include "webospaths.h"
 
 bool AppInstallerUtility::m_locked = false;
+boost::signals2::signal<void ()> AppInstallerUtility::signalIdle;
 
 std::string getOpkgLockPath(std::string installBasePath)
 {
@@ -77,6 +78,7 @@ gboolean AppInstallerUtility::cbChildProgress(GIOChannel *channel, GIOCondition
 
 void AppInstallerUtility::cbChildComplete(GPid pid, gint status, gpointer user_data) {
     LOG_DEBUG("child pid %d done with status %d", pid, status);
+    Tracing::childExited(pid);
 
     AppInstallerUtility *installer = reinterpret_cast<AppInstallerUtility*>(user_data);
     AppInstallerUtility::m_locked = false;
@@ -85,6 +87,15 @@ void AppInstallerUtility::cbChildComplete(GPid pid, gint status, gpointer user_d
         installer->m_funcComplete(status);
 }
 
+void AppInstallerUtility::cbChildCanceled(GPid pid, gint status, gpointer data)
+{
+    LOG_DEBUG("canceled child pid %d done with status %d", pid, status);
+    Tracing::childExited(pid);
+
+    AppInstallerUtility::m_locked = false;
+    signalIdle();
+}
+
 AppInstallerUtility::AppInstallerUtility()
     : m_childStdOutChannel(NULL),
       m_childStdOutSource(NULL),
@@ -106,6 +117,23 @@ AppInstallerUtility::Result AppInstallerUtility::install(std::string target,
                                                          std::string installBasePath,
                                                          FuncProgress cbProgress,
                                                          FuncComplete cbComplete)
+{
+    return install(std::vector<std::string>({ std::move(target) }),
+                   verify,
+                   allowDowngrade,
+                   allowReInstall,
+                   std::move(installBasePath),
+                   std::move(cbProgress),
+                   std::move(cbComplete));
+}
+
+AppInstallerUtility::Result AppInstallerUtility::install(const std::vector<std::string> &targets,
+                                                         bool verify,
+                                                         bool allowDowngrade,
+                                                         bool allowReInstall,
+                                                         std::string installBasePath,
+                                                         FuncProgress cbProgress,
+                                                         FuncComplete cbComplete)
 {
     clear();
 
@@ -118,7 +146,7 @@ AppInstallerUtility::Result AppInstallerUtility::install(std::string target,
         return LOCKED;
     restore(opkgBasePath);
 
-    gchar* argv[16] = {0}; ///WARNING! look out below if number of params goes > size of this array (keep them in sync)
+    std::vector<gchar*> argv;
     GError* gerr = NULL;
     GSpawnFlags flags = (GSpawnFlags)(G_SPAWN_SEARCH_PATH |
                                       G_SPAWN_STDERR_TO_DEV_NULL |
@@ -126,36 +154,38 @@ AppInstallerUtility::Result AppInstallerUtility::install(std::string target,
     GPid childPid;
     gint childStdoutFd;
     gboolean result;
-    int index = 0;
 
-    argv[index++] = (gchar *) WEBOS_INSTALL_SBINDIR "/setcpushares-task";
-    argv[index++] = (gchar *) WEBOS_INSTALL_BINDIR "/ApplicationInstallerUtility";
-    argv[index++] = (gchar *) "-c";
-    argv[index++] = (gchar *) "install";
-    argv[index++] = (gchar *) "-p";
-    argv[index++] = (gchar *) target.c_str();
-    argv[index++] = (gchar *) "-f";
-    argv[index++] = (gchar *) Settings::instance().getOpkgConfPath().c_str();
-    argv[index++] = (gchar *) "-u";
-    argv[index++] = (gchar *) "0";//Utils::toString(uncompressedSizeInKB).c_str();
+    if (!Settings::instance().getCpusharesPath().empty())
+        argv.push_back((gchar *) Settings::instance().getCpusharesPath().c_str());
+    argv.push_back((gchar *) Settings::instance().getInstallerUtilityPath().c_str());
+    argv.push_back((gchar *) "-c");
+    argv.push_back((gchar *) "install");
+    for (const std::string &target : targets) {
+        argv.push_back((gchar *) "-p");
+        argv.push_back((gchar *) target.c_str());
+    }
+    argv.push_back((gchar *) "-f");
+    argv.push_back((gchar *) Settings::instance().getOpkgConfPath().c_str());
+    argv.push_back((gchar *) "-u");
+    argv.push_back((gchar *) "0");
 
     // When the app will be installed in the external storage,
     // Send the base path for installing apps in it.
     if (!installBasePath.empty()) {
-        argv[index++] = (gchar *) "-l";
-        argv[index++] = (gchar *) installBasePath.c_str();
+        argv.push_back((gchar *) "-l");
+        argv.push_back((gchar *) installBasePath.c_str());
     } else {
-        argv[index++] = (gchar*) "-t";
+        argv.push_back((gchar*) "-t");
         if (verify)
-            argv[index++] = (gchar*) "internal";
+            argv.push_back((gchar*) "internal");
         else
-            argv[index++] = (gchar*) "developer";
+            argv.push_back((gchar*) "developer");
     }
     if (allowDowngrade)
-        argv[index++] = (gchar*) "-d";
+        argv.push_back((gchar*) "-d");
     if (allowReInstall)
-        argv[index++] = (gchar*) "-r";
-    argv[index] = NULL;
+        argv.push_back((gchar*) "-r");
+    argv.push_back(NULL);
 
     std::string opkgLockPath = getOpkgLockPath(installBasePath);
     if (!Utils::make_dir(opkgLockPath.c_str(), true)) {
@@ -167,7 +197,7 @@ AppInstallerUtility::Result AppInstallerUtility::install(std::string target,
     }
 
     result = g_spawn_async_with_pipes(NULL,
-                                      argv,
+                                      argv.data(),
                                       NULL,
                                       flags,
                                       NULL,
@@ -184,6 +214,11 @@ AppInstallerUtility::Result AppInstallerUtility::install(std::string target,
         g_source_set_callback(m_childStdOutSource, (GSourceFunc)cbChildProgress, this, NULL);
         MainApp::instance().attach(m_childStdOutSource);
 
+        std::string traceKey;
+        for (const std::string &target : targets)
+            traceKey += (traceKey.empty() ? "" : ",") + target;
+        Tracing::childStarted(childPid, "opkg install", traceKey);
+
         guint sourceId = g_child_watch_add_full(G_PRIORITY_DEFAULT_IDLE, childPid, cbChildComplete, this, NULL);
 
         m_pid = childPid;
@@ -228,8 +263,9 @@ AppInstallerUtility::Result AppInstallerUtility::remove(std::string appId, bool
     gboolean result;
     int index = 0;
 
-    argv[index++] = (gchar *) WEBOS_INSTALL_SBINDIR "/setcpushares-task";
-    argv[index++] = (gchar *) WEBOS_INSTALL_BINDIR "/ApplicationInstallerUtility";
+    if (!Settings::instance().getCpusharesPath().empty())
+        argv[index++] = (gchar *) Settings::instance().getCpusharesPath().c_str();
+    argv[index++] = (gchar *) Settings::instance().getInstallerUtilityPath().c_str();
     argv[index++] = (gchar *) "-c";
     argv[index++] = (gchar *) "remove";
     argv[index++] = (gchar *) "-p";
@@ -264,6 +300,8 @@ AppInstallerUtility::Result AppInstallerUtility::remove(std::string appId, bool
         g_source_set_callback(m_childStdOutSource, (GSourceFunc)cbChildProgress, this, NULL);
         MainApp::instance().attach(m_childStdOutSource);
 
+        Tracing::childStarted(childPid, "opkg remove", appId);
+
         guint sourceId = g_child_watch_add_full(G_PRIORITY_DEFAULT_IDLE, childPid, cbChildComplete, this, NULL);
 
         m_pid = childPid;
@@ -296,13 +334,25 @@ bool AppInstallerUtility::cancel()
     int result = System::kill(m_pid);
     LOG_DEBUG("[AppInstallerUtility] killed: %d", result);
 
+    // this instance can be destroyed before the child is reaped,
+    // so reap it without this and keep opkg locked until then
+    if (m_sourceId != 0)
+        g_source_remove(m_sourceId);
+    g_child_watch_add(m_pid, cbChildCanceled, NULL);
+
     m_funcProgress = nullptr;
+    m_funcComplete = nullptr;
 
     clear();
 
     return true;
 }
 
+bool AppInstallerUtility::isBusy()
+{
+    return m_locked;
+}
+
 void AppInstallerUtility::clear()
 {
     if (m_childStdOutChannel) {
@@ -17,16 +17,18 @@
 #ifndef APPINSTALLERUTILITY_H
 #define APPINSTALLERUTILITY_H
 
+#include <boost/signals2.hpp>
 #include <functional>
 #include <glib.h>
 #include <string>
+#include <vector>
 
 //! This class for wrapping @WEBOS_INSTALL_BINDIR@/ApplicationInstallerUtility
 class AppInstallerUtility {
+public:
     typedef std::function<void (const char*)> FuncProgress;
     typedef std::function<void (int)> FuncComplete;
 
-public:
     typedef enum {
         SUCCESS = 0,
         FAIL,
@@ -49,6 +51,17 @@ public:
                    FuncProgress cbProgress,
                    FuncComplete cbComplete);
 
+    /*! request install of several packages to @WEBOS_INSTALL_BINDIR@/ApplicationInstallerUtility
+     * They are installed by one opkg run, so opkg lock and status file update are done once
+     */
+    Result install(const std::vector<std::string> &targets,
+                   bool verify,
+                   bool allowDowngrade,
+                   bool allowReInstall,
+                   std::string installBasePath,
+                   FuncProgress cbProgress,
+                   FuncComplete cbComplete);
+
     //! request remove to @WEBOS_INSTALL_BINDIR@/ApplicationInstallerUtility
     Result remove(std::string appId,
                   bool verify,
@@ -56,9 +69,17 @@ public:
                   FuncProgress cbProgress,
                   FuncComplete cbComplete);
 
-    //! cancel processing
+    /*! cancel processing
+     * child process is killed and complete callback isn't called anymore
+     */
     bool cancel();
 
+    //! check whether ApplicationInstallerUtility is still running
+    static bool isBusy();
+
+    //! signal for notify canceled child is reaped and opkg can be used again
+    static boost::signals2::signal<void ()> signalIdle;
+
     //! clear resource
     void clear();
 
@@ -69,6 +90,9 @@ protected:
     //! watch function for child complete
     static void cbChildComplete(GPid pid, gint status, gpointer data);
 
+    //! watch function for canceled child
+    static void cbChildCanceled(GPid pid, gint status, gpointer data);
+
     /*! checks it's locked or not
      * opkg can handle only one command at once
      */
@@ -21,7 +21,9 @@
 #include <stdlib.h>
 
 #include "AppPackage.h"
+#include "IpkReader.h"
 #include "base/Logging.h"
+#include "base/Tracing.h"
 #include "base/Utils.h"
 
 #define FILENAME_CONTROL "control.tar.gz"
@@ -30,6 +32,8 @@
 
 void AppPackage::cbExtractComplete(GPid pid, gint status, gpointer user_data)
 {
+    Tracing::childExited(pid);
+
     AppPackage *package = reinterpret_cast<AppPackage*>(user_data);
     if (!package)
         return;
@@ -68,6 +72,9 @@ bool AppPackage::extract(std::string& targetFile,
                          std::string& targetPath,
                          std::function<void (bool)> onExtract)
 {
+    m_targetItemList.clear();
+    m_canceled = false;
+
     gchar* argv[16] = {0};
     GError* gerr = NULL;
     GSpawnFlags flags = (GSpawnFlags)(G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD);
@@ -94,9 +101,6 @@ bool AppPackage::extract(std::string& targetFile,
     if (targetItem & DEBIAN)
         Utils::remove_file(targetPath + "/" + FILENAME_DEBIAN);
 
-    m_targetItemList.clear();
-    m_canceled = false;
-
     result = g_spawn_async(targetPath.c_str(),
                            argv,
                            NULL,
@@ -107,6 +111,7 @@ bool AppPackage::extract(std::string& targetFile,
                            &gerr);
 
     if (result) {
+        Tracing::childStarted(childPid, "ar extract", targetFile);
         g_child_watch_add(childPid, cbExtractComplete, this);
 
         m_targetFile = targetFile;
@@ -164,6 +169,7 @@ bool AppPackage::extractOneItem()
                            &gerr);
 
     if (result) {
+        Tracing::childStarted(childPid, "tar extract", targetFile);
         g_child_watch_add(childPid, cbExtractComplete, this);
         return true;
     }
@@ -182,34 +188,50 @@ bool AppPackage::extractOneItem()
 bool AppPackage::parseControl(std::string controlFilePath, AppPackage::Control &control)
 {
     std::ifstream file(controlFilePath.c_str());
+
+    if (file.good())
+        return parseControl(file, control);
+
+    return false;
+}
+
+bool AppPackage::readControl(const std::string &targetFile, AppPackage::Control &control)
+{
+    IpkReader reader;
+    std::string content;
+
+    if (!reader.open(targetFile) || !reader.readFile(FILENAME_CONTROL, "control", content))
+        return false;
+
+    std::istringstream stream(content);
+    return parseControl(stream, control);
+}
+
+bool AppPackage::parseControl(std::istream &stream, AppPackage::Control &control)
+{
     std::string line;
     std::string field, value;
 
-    if (file.good()) {
-        while(std::getline(file, line)) {
-            std::istringstream lineStream(line);
-
-            if (!std::getline(lineStream, field, ':'))
-                continue;
-            if (!std::getline(lineStream, value))
-                continue;
-
-            boost::trim(value);
-            if (field == "Package")
-                control.m_package = value;
-            else if (field == "Version")
-                control.m_version = value;
-            else if (field == "Architecture")
-                control.m_architecture = value;
-            else if (field == "Installed-Size")
-                control.m_installedSize = boost::lexical_cast<uint64_t>(value);
-        }
-
-        file.close();
-        return true;
+    while(std::getline(stream, line)) {
+        std::istringstream lineStream(line);
+
+        if (!std::getline(lineStream, field, ':'))
+            continue;
+        if (!std::getline(lineStream, value))
+            continue;
+
+        boost::trim(value);
+        if (field == "Package")
+            control.m_package = value;
+        else if (field == "Version")
+            control.m_version = value;
+        else if (field == "Architecture")
+            control.m_architecture = value;
+        else if (field == "Installed-Size")
+            control.m_installedSize = boost::lexical_cast<uint64_t>(value);
     }
 
-    return false;
+    return true;
 }
 
 void AppPackage::saveInstalledSizeToControlFile(std::string controlFilePath, uint64_t unpackFileSize)
@@ -20,6 +20,7 @@
 #include <deque>
 #include <functional>
 #include <glib.h>
+#include <istream>
 #include <string>
 
 //! AppPackage class helps extracting ipk file and parse items
@@ -49,7 +50,7 @@ public:
         uint64_t m_installedSize;
     };
 
-    //! Extract targetFile(*.ipk) to targetPath
+    //! Extract targetFile(*.ipk) to targetPath with ar & tar command
     bool extract(std::string& targetFile,
                  int targetItem,
                  std::string& targetPath,
@@ -58,6 +59,11 @@ public:
     //! Parse control file
     bool parseControl(std::string controlFilePath, AppPackage::Control &control);
 
+    /*! Read control of targetFile(*.ipk) in memory and parse it.
+     * Only ar header table and control member are read, data member is never touched.
+     */
+    bool readControl(const std::string &targetFile, AppPackage::Control &control);
+
     //! Save installed size in control file
     void saveInstalledSizeToControlFile(std::string controlFilePath, uint64_t unpackFileSize);
 
@@ -74,6 +80,9 @@ protected:
     //! Extract item file
     bool extractOneItem();
 
+    //! Parse control fields from stream
+    bool parseControl(std::istream &stream, AppPackage::Control &control);
+
 private:
     std::string m_targetFile;
     std::string m_targetPath;
@@ -14,17 +14,21 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <boost/algorithm/string/join.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <thread>
 
 #include "AppInstallerUtilityErrors.h"
 #include "base/JUtil.h"
 #include "base/Utils.h"
 #include "base/LSUtils.h"
 #include "base/Logging.h"
+#include "base/Tracing.h"
 #include "CallChainEventHandler.h"
 #include "settings/Settings.h"
 #include "PackageInfo.h"
 #include "ServiceInfo.h"
+#include "SmackApplier.h"
 
 using namespace std::placeholders;
 
@@ -36,6 +40,8 @@ namespace CallChainEventHandler
         : LSCallItem(serviceName, "luna://com.webos.applicationManager/running", "{}", sessionId),
           m_id(std::move(id))
     {
+        // query only, it's safe to send again
+        setRetry(Settings::instance().getLunaCallRetries(), Settings::instance().getLunaCallRetryBackoff());
     }
 
     bool AppRunning::onReceiveCall(pbnjson::JValue message)
@@ -88,6 +94,9 @@ namespace CallChainEventHandler
         pbnjson::JValue payload = pbnjson::Object();
         payload.put("id", id);
         setPayload(JUtil::toSimpleString(std::move(payload)).c_str());
+
+        // query only, it's safe to send again
+        setRetry(Settings::instance().getLunaCallRetries(), Settings::instance().getLunaCallRetryBackoff());
     }
 
     bool AppInfo::onReceiveCall(pbnjson::JValue message)
@@ -188,7 +197,7 @@ namespace CallChainEventHandler
                 std::string uri = "luna://" + serviceInfo.getId() + "/quit";
                 LSCaller caller = LSUtils::acquireCaller("com.webos.appInstallService");
                 LOG_DEBUG("[NODEJS_SVC_CLOSE] uri : %s, session : %s", uri.c_str(), m_sessionId ? m_sessionId : "(nullptr)");
-                if (!caller.CallOneReply(uri.c_str(), "{}", m_sessionId, cbQuit, this, NULL, errorText)) {
+                if (!caller.CallOneReply(uri.c_str(), "{}", m_sessionId, std::bind(&SvcClose::onQuit, this, _1, _2), NULL, errorText, getTimeout())) {
                     Utils::async([=] { onFinished(false, std::move(errorText)); });
                     break;
                 }
@@ -211,13 +220,9 @@ namespace CallChainEventHandler
         return true;
     }
 
-    bool SvcClose::cbQuit(LSHandle *lshandle, LSMessage *msg, void *user_data)
+    void SvcClose::onQuit(const char *payload, bool hubError)
     {
-        SvcClose *item = static_cast<SvcClose*>(user_data);
-        if (!item)
-            return false;
-
-        pbnjson::JValue json = JUtil::parse(LSMessageGetPayload(msg), std::string(""));
+        pbnjson::JValue json = JUtil::parseTrusted(payload);
         bool returnValue = json["returnValue"].asBool();
 
         if (!returnValue) {
@@ -225,17 +230,15 @@ namespace CallChainEventHandler
             if (errorText.empty())
                 errorText = "Failed to quit nodejs service";
 
-            Utils::async([=] { item->onFinished(false, std::move(errorText)); });
+            Utils::async([=] { onFinished(false, std::move(errorText)); });
 
-            return true;
+            return;
         }
 
-        ++(item->m_numResponse);
-        if (item->m_numResponse == item->m_numServices) {
-            Utils::async([=] { item->onFinished(true, ""); });
+        ++m_numResponse;
+        if (m_numResponse == m_numServices) {
+            Utils::async([=] { onFinished(true, ""); });
         }
-
-        return true;
     }
 
     RemoveDb::RemoveDb(const char* serviceName, const char* sessionId, pbnjson::JValue owners)
@@ -355,4 +358,138 @@ namespace CallChainEventHandler
         sync();
         onFinished(true, std::string(""));
     }
+
+    RunCommand::RunCommand(std::vector<std::string> argv, std::string errorText)
+        : m_argv(std::move(argv)),
+          m_errorText(std::move(errorText)),
+          m_pid(-1),
+          m_sourceId(0)
+    {
+    }
+
+    RunCommand::~RunCommand()
+    {
+        if (m_sourceId == 0)
+            return;
+
+        // item is destroyed before child exits, just reap it
+        g_source_remove(m_sourceId);
+        g_child_watch_add(m_pid, [] (GPid pid, gint status, gpointer user_data) {
+            Tracing::childExited(pid);
+            g_spawn_close_pid(pid);
+        }, NULL);
+    }
+
+    bool RunCommand::Call()
+    {
+        std::vector<gchar*> argv;
+        for (auto &arg : m_argv)
+            argv.push_back((gchar *) arg.c_str());
+        argv.push_back(NULL);
+
+        GError *gerr = NULL;
+        GSpawnFlags flags = (GSpawnFlags)(G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD);
+
+        LOG_DEBUG("Executing %s", boost::algorithm::join(m_argv, " ").c_str());
+
+        if (!g_spawn_async(NULL, argv.data(), NULL, flags, NULL, NULL, &m_pid, &gerr)) {
+            LOG_ERROR(MSGID_EXEC_FAIL, 2,
+                      PMLOGKS(REASON, m_argv.front().c_str()),
+                      PMLOGKS(LOGKEY_ERRTEXT, gerr ? gerr->message : ""),
+                      "Failed to execute command");
+            if (gerr)
+                g_error_free(gerr);
+
+            onError(m_errorText);
+            return false;
+        }
+
+        Tracing::childStarted(m_pid, "exec", boost::algorithm::join(m_argv, " "));
+        m_sourceId = g_child_watch_add(m_pid, cbComplete, this);
+        return true;
+    }
+
+    void RunCommand::cbComplete(GPid pid, gint status, gpointer user_data)
+    {
+        Tracing::childExited(pid);
+        g_spawn_close_pid(pid);
+
+        RunCommand *item = reinterpret_cast<RunCommand*>(user_data);
+        if (!item)
+            return;
+
+        item->m_sourceId = 0;
+        LOG_DEBUG("%s exit status is %d", item->m_argv.front().c_str(), (int)WEXITSTATUS(status));
+
+        if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+            LOG_ERROR(MSGID_EXEC_FAIL, 2,
+                      PMLOGKS(REASON, item->m_argv.front().c_str()),
+                      PMLOGKFV(STATUS, "%d", status),
+                      "Non-zero exit code from command");
+            item->onFinished(false, item->m_errorText);
+            return;
+        }
+
+        item->onFinished(true, std::string(""));
+    }
+
+    LabelSmack::LabelSmack(std::string path, std::string access, bool transmute, std::string exec)
+        : m_path(std::move(path)),
+          m_labeler(std::move(access), transmute, std::move(exec), SMACK_LABEL_JOBS, Settings::instance().getSmackXattrPrefix())
+    {
+    }
+
+    bool LabelSmack::Call()
+    {
+        LOG_DEBUG("Labeling %s", m_path.c_str());
+
+        // item might be released while worker runs (e.g. task is canceled),
+        // so worker has its own copies and finds item through weak pointer
+        std::weak_ptr<LabelSmack> item = shared_from_this();
+        std::string path = m_path;
+        SmackLabeler labeler = m_labeler;
+
+        // walking big tree takes long, don't block main loop
+        std::thread([item, path, labeler] {
+            std::string errorText;
+            bool result = labeler.label(path, errorText);
+
+            Utils::async([item, result, errorText] {
+                if (std::shared_ptr<LabelSmack> self = item.lock())
+                    self->onLabeled(result, errorText);
+            });
+        }).detach();
+
+        return true;
+    }
+
+    void LabelSmack::onLabeled(bool result, const std::string &errorText)
+    {
+        if (result) {
+            onFinished(true, std::string(""));
+            return;
+        }
+
+        LOG_ERROR(MSGID_INSTALL_SMACK_FAIL, 2,
+                  PMLOGKS(PATH, m_path.c_str()),
+                  PMLOGKS(LOGKEY_ERRTEXT, errorText.c_str()),
+                  "Failed to set SMACK labels");
+        onFinished(false, std::string("unable to set SMACK labels"));
+    }
+
+    ApplySmackRules::ApplySmackRules()
+    {
+    }
+
+    bool ApplySmackRules::Call()
+    {
+        SmackApplier::instance().apply([this] (bool result) {
+            if (result)
+                onFinished(true, std::string(""));
+            else
+                onFinished(false, std::string("unable to execute smackctl command"));
+        });
+
+        return true;
+    }
 }
@@ -17,8 +17,14 @@
 #ifndef CALLCHAIN_EVENT_HANDLER_H
 #define CALLCHAIN_EVENT_HANDLER_H
 
+#include <glib.h>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "base/CallChain.h"
 #include "installer/AppInstallerUtility.h"
+#include "installer/SmackLabeler.h"
 
 namespace CallChainEventHandler
 {
@@ -70,7 +76,7 @@ namespace CallChainEventHandler
         virtual bool Call();
 
     protected:
-        static bool cbQuit(LSHandle *lshandle, LSMessage *msg, void *user_data);
+        void onQuit(const char *payload, bool hubError);
 
     private:
         int m_numResponse;
@@ -114,6 +120,53 @@ namespace CallChainEventHandler
         AppInstallerUtility m_installerUtility;
     };
 
+    /*! Run command without blocking main loop.
+     * It's finished with errorText when command can't be executed or exits with non-zero
+     */
+    class RunCommand : public CallItem {
+    public:
+        RunCommand(std::vector<std::string> argv, std::string errorText);
+        virtual ~RunCommand();
+
+        virtual bool Call();
+
+    protected:
+        //! watch function for child complete
+        static void cbComplete(GPid pid, gint status, gpointer user_data);
+
+    private:
+        std::vector<std::string> m_argv;
+        std::string m_errorText;
+
+        GPid m_pid;
+        guint m_sourceId;
+    };
+
+    //! Set SMACK labels of directory tree in worker thread
+    //! Label files under path in worker thread, it should be created by std::make_shared
+    class LabelSmack : public CallItem, public std::enable_shared_from_this<LabelSmack> {
+    public:
+        LabelSmack(std::string path, std::string access, bool transmute, std::string exec = "");
+
+        virtual bool Call();
+
+    protected:
+        //! It's called on main loop when worker is done, only if item is still alive
+        void onLabeled(bool result, const std::string &errorText);
+
+    private:
+        std::string m_path;
+        SmackLabeler m_labeler;
+    };
+
+    //! Reload SMACK rules, shared with other tasks through SmackApplier
+    class ApplySmackRules : public CallItem {
+    public:
+        ApplySmackRules();
+
+        virtual bool Call();
+    };
+
 }
 
 #endif
@@ -112,118 +112,127 @@ enum TaskStep {
     //SMACK Related end
 };
 
+//! number of TaskStep values, tables indexed by TaskStep have this size
+static const int TASK_STEP_COUNT = RemoveSmackComplete + 1;
+
+//! It converts TaskStep from/to its name with static table
 class TaskStepParser {
-    std::map<std::string, TaskStep> enumMap;
+    struct Entry {
+        const char *name;
+        TaskStep step;
+    };
+
+    static constexpr Entry s_entries[] = {
+        { "Unknown", Unknown },
+
+        { "IconDownloadNeeded", IconDownloadNeeded },
+        { "IconDownloadRequested", IconDownloadRequested },
+        { "IconDownloadCurrent", IconDownloadCurrent },
+        { "IconDownloadPaused", IconDownloadPaused },
+        { "IconDownloadComplete", IconDownloadComplete },
+
+        { "IpkDownloadNeeded", IpkDownloadNeeded },
+        { "IpkDownloadRequested", IpkDownloadRequested },
+        { "IpkDownloadCurrent", IpkDownloadCurrent },
+        { "IpkDownloadPaused", IpkDownloadPaused },
+        { "IpkDownloadComplete", IpkDownloadComplete },
+
+        { "IpkInstallNeeded", IpkInstallNeeded },
+        { "UnpackagedInstallNeeded", UnpackagedInstallNeeded },
+        { "IpkInstallRequested", IpkInstallRequested },
+        { "IpkInstallStarting", IpkInstallStarting },
+        { "IpkInstallUnpacking", IpkInstallUnpacking },
+        { "IpkInstallVerifying", IpkInstallVerifying },
+        { "IpkInstallCurrent", IpkInstallCurrent },
+        { "IpkInstallComplete", IpkInstallComplete },
+
+        { "IpkRemoveNeeded", IpkRemoveNeeded },
+        { "IpkRemoveRequested", IpkRemoveRequested },
+        { "IpkRemoveStarted", IpkRemoveStarted },
+        { "IpkRemoveComplete", IpkRemoveComplete },
+        { "InstallCanceled", InstallCanceled },
+
+        { "ErrorDownload", ErrorDownload },
+        { "ErrorInstall", ErrorInstall },
+        { "ErrorRemove", ErrorRemove },
+
+        { "Finish", Finish },
+
+        { "ServiceInstallNeeded", ServiceInstallNeeded },
+        { "ServiceInstallRequested", ServiceInstallRequested },
+        { "ServiceInstallComplete", ServiceInstallComplete },
+
+        { "InstallComplete", InstallComplete },
+        { "RemoveComplete", RemoveComplete },
+
+        { "AppCloseNeeded", AppCloseNeeded },
+        { "AppCloseRequested", AppCloseRequested },
+        { "AppCloseComplete", AppCloseComplete },
+
+        { "IpkParseNeeded", IpkParseNeeded },
+        { "IpkParseRequested", IpkParseRequested },
+        { "IpkParseComplete", IpkParseComplete },
+
+        { "ServiceUninstallNeeded", ServiceUninstallNeeded },
+        { "ServiceUninstallRequested", ServiceUninstallRequested },
+        { "ServiceUninstallComplete", ServiceUninstallComplete },
+
+        { "RemoveNeeded", RemoveNeeded },
+        { "RemoveStarted", RemoveStarted },
+
+        { "DataRemoveNeeded", DataRemoveNeeded },
+        { "DataRemoveRequested", DataRemoveRequested },
+        { "DataRemoveComplete", DataRemoveComplete },
+
+        { "RemoveJailNeeded", RemoveJailNeeded },
+        { "RemoveJailRequested", RemoveJailRequested },
+        { "RemoveJailComplete", RemoveJailComplete },
+
+        { "InstallRONeeded", InstallRONeeded },
+        { "InstallRORequested", InstallRORequested },
+        { "InstallROComplete", InstallROComplete },
+
+        { "UninstallRONeeded", UninstallRONeeded },
+        { "UninstallRORequested", UninstallRORequested },
+        { "UninstallROComplete", UninstallROComplete },
+
+        { "GetIpkInfoNeeded", GetIpkInfoNeeded },
+        { "GetIpkInfoRequested", GetIpkInfoRequested },
+        { "GetIpkInfoComplete", GetIpkInfoComplete },
+
+        { "PostDoneNeeded", PostDoneNeeded },
+        { "PostDoneRequested", PostDoneRequested },
+        { "PostDoneComplete", PostDoneComplete },
+
+        { "IpkVerifyNeeded", IpkVerifyNeeded },
+        { "IpkVerifyRequested", IpkVerifyRequested },
+        { "IpkVerifyComplete", IpkVerifyComplete },
+
+        { "InstallSmackNeeded", InstallSmackNeeded },
+        { "InstallSmackRequested", InstallSmackRequested },
+        { "InstallSmackComplete", InstallSmackComplete },
+
+        { "RemoveSmackNeeded", RemoveSmackNeeded },
+        { "RemoveSmackRequested", RemoveSmackRequested },
+        { "RemoveSmackComplete", RemoveSmackComplete },
+    };
+
 public:
-    TaskStepParser()
+    //! It's used only when step graphs are loaded, so linear search is enough
+    static TaskStep stringToEnumStep(const std::string &strStep)
     {
-        enumMap["Unknown"] = Unknown;
-
-        enumMap["IconDownloadNeeded"] = IconDownloadNeeded;
-        enumMap["IconDownloadRequested"] = IconDownloadRequested;
-        enumMap["IconDownloadCurrent"] = IconDownloadCurrent;
-        enumMap["IconDownloadPaused"] = IconDownloadPaused;
-        enumMap["IconDownloadComplete"] = IconDownloadComplete;
-
-        enumMap["IpkDownloadNeeded"] = IpkDownloadNeeded;
-        enumMap["IpkDownloadRequested"] = IpkDownloadRequested;
-        enumMap["IpkDownloadCurrent"] = IpkDownloadCurrent;
-        enumMap["IpkDownloadPaused"] = IpkDownloadPaused;
-        enumMap["IpkDownloadComplete"] = IpkDownloadComplete;
-
-        enumMap["IpkInstallNeeded"] = IpkInstallNeeded;
-        enumMap["UnpackagedInstallNeeded"] = UnpackagedInstallNeeded;
-        enumMap["IpkInstallRequested"] = IpkInstallRequested;
-        enumMap["IpkInstallStarting"] = IpkInstallStarting;
-        enumMap["IpkInstallUnpacking"] = IpkInstallUnpacking;
-        enumMap["IpkInstallVerifying"] = IpkInstallVerifying;
-        enumMap["IpkInstallCurrent"] = IpkInstallCurrent;
-        enumMap["IpkInstallComplete"] = IpkInstallComplete;
-
-        enumMap["IpkRemoveNeeded"] = IpkRemoveNeeded;
-        enumMap["IpkRemoveRequested"] = IpkRemoveRequested;
-        enumMap["IpkRemoveStarted"] = IpkRemoveStarted;
-        enumMap["IpkRemoveComplete"] = IpkRemoveComplete;
-        enumMap["InstallCanceled"] = InstallCanceled;
-
-        enumMap["ErrorDownload"] = ErrorDownload;
-        enumMap["ErrorInstall"] = ErrorInstall;
-        enumMap["ErrorRemove"] = ErrorRemove;
-
-        enumMap["Finish"] = Finish;
-
-        enumMap["ServiceInstallNeeded"] = ServiceInstallNeeded;
-        enumMap["ServiceInstallRequested"] = ServiceInstallRequested;
-        enumMap["ServiceInstallComplete"] = ServiceInstallComplete;
-
-        enumMap["InstallComplete"] = InstallComplete;
-        enumMap["RemoveComplete"] = RemoveComplete;
-
-        enumMap["AppCloseNeeded"] = AppCloseNeeded;
-        enumMap["AppCloseRequested"] = AppCloseRequested;
-        enumMap["AppCloseComplete"] = AppCloseComplete;
-
-        enumMap["IpkParseNeeded"] = IpkParseNeeded;
-        enumMap["IpkParseRequested"] = IpkParseRequested;
-        enumMap["IpkParseComplete"] = IpkParseComplete;
-
-        enumMap["ServiceUninstallNeeded"] = ServiceUninstallNeeded;
-        enumMap["ServiceUninstallRequested"] = ServiceUninstallRequested;
-        enumMap["ServiceUninstallComplete"] = ServiceUninstallComplete;
-
-        enumMap["RemoveNeeded"] = RemoveNeeded;
-        enumMap["RemoveStarted"] = RemoveStarted;
-
-        enumMap["DataRemoveNeeded"] = DataRemoveNeeded;
-        enumMap["DataRemoveRequested"] = DataRemoveRequested;
-        enumMap["DataRemoveComplete"] = DataRemoveComplete;
-
-        enumMap["RemoveJailNeeded"] = RemoveJailNeeded;
-        enumMap["RemoveJailRequested"] = RemoveJailRequested;
-        enumMap["RemoveJailComplete"] = RemoveJailComplete;
-
-        enumMap["InstallRONeeded"] = InstallRONeeded;
-        enumMap["InstallRORequested"] = InstallRORequested;
-        enumMap["InstallROComplete"] = InstallROComplete;
-
-        enumMap["UninstallRONeeded"] = UninstallRONeeded;
-        enumMap["UninstallRORequested"] = UninstallRORequested;
-        enumMap["UninstallROComplete"] = UninstallROComplete;
-
-        enumMap["GetIpkInfoNeeded"] = GetIpkInfoNeeded;
-        enumMap["GetIpkInfoRequested"] = GetIpkInfoRequested;
-        enumMap["GetIpkInfoComplete"] = GetIpkInfoComplete;
-
-        enumMap["PostDoneNeeded"] = PostDoneNeeded;
-        enumMap["PostDoneRequested"] = PostDoneRequested;
-        enumMap["PostDoneComplete"] = PostDoneComplete;
-
-        enumMap["IpkVerifyNeeded"] = IpkVerifyNeeded;
-        enumMap["IpkVerifyRequested"] = IpkVerifyRequested;
-        enumMap["IpkVerifyComplete"] = IpkVerifyComplete;
-
-        enumMap["InstallSmackNeeded"] = InstallSmackNeeded;
-        enumMap["InstallSmackRequested"] = InstallSmackRequested;
-        enumMap["InstallSmackComplete"] = InstallSmackComplete;
-
-        enumMap["RemoveSmackNeeded"] = RemoveSmackNeeded;
-        enumMap["RemoveSmackRequested"] = RemoveSmackRequested;
-        enumMap["RemoveSmackComplete"] = RemoveSmackComplete;
-    }
+        for (const Entry &entry : s_entries)
+            if (strStep == entry.name)
+                return entry.step;
 
-    TaskStep stringToEnumStep(const std::string &strStep)
-    {
-        std::map<std::string, TaskStep>::const_iterator enumIter = enumMap.find(strStep);
-        if (enumIter == enumMap.end())
-            return Undefied;
-        return enumIter->second;
+        return Undefied;
     }
 
-    std::string enumToStringStep(const TaskStep step)
+    static std::string enumToStringStep(const TaskStep step)
     {
-        for (auto it = enumMap.begin(); it != enumMap.end(); it++)
-            if (it->second == step)
-                return it->first;
+        for (const Entry &entry : s_entries)
+            if (entry.step == step)
+                return entry.name;
 
         return std::string("");
     }
@@ -0,0 +1,245 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+#include <fstream>
+#include <sys/wait.h>
+
+#include "IpkBatchInstaller.h"
+#include "base/Logging.h"
+#include "installer/AppInstaller.h"
+#include "installer/AppInstallerUtilityErrors.h"
+#include "settings/Settings.h"
+
+//! opkg owner name of batch runs
+#define IPK_BATCH_OWNER "IpkBatchInstaller"
+
+IpkBatchInstaller::IpkBatchInstaller()
+    : m_waiting(false)
+{
+}
+
+IpkBatchInstaller::~IpkBatchInstaller()
+{
+}
+
+void IpkBatchInstaller::install(Request request)
+{
+    m_pending.push_back(std::move(request));
+
+    // running one can't take this request, it'll be served by next run
+    if (m_running.empty())
+        acquire();
+}
+
+bool IpkBatchInstaller::cancel(const std::string &appId)
+{
+    for (auto it = m_pending.begin(); it != m_pending.end(); ++it) {
+        if (it->appId == appId) {
+            m_pending.erase(it);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void IpkBatchInstaller::acquire()
+{
+    if (m_waiting || m_pending.empty())
+        return;
+
+    m_waiting = true;
+    AppInstaller::instance().acquireOpkg(IPK_BATCH_OWNER, [this] { onOpkgAcquired(); });
+}
+
+void IpkBatchInstaller::onOpkgAcquired()
+{
+    m_waiting = false;
+
+    // all of requests are canceled while waiting
+    if (m_pending.empty()) {
+        AppInstaller::instance().releaseOpkg(IPK_BATCH_OWNER);
+        return;
+    }
+
+    // opkg options are common for one run, the others wait for next run
+    std::deque<Request> remains;
+    for (auto &request : m_pending) {
+        if (m_running.empty() || isCompatible(m_running.front(), request))
+            m_running.push_back(std::move(request));
+        else
+            remains.push_back(std::move(request));
+    }
+    m_pending.swap(remains);
+
+    std::vector<std::string> targets;
+    for (const auto &request : m_running)
+        targets.push_back(request.ipkFile);
+
+    LOG_DEBUG("[IpkBatchInstaller] install %zu ipks by one run", targets.size());
+
+    const Request &front = m_running.front();
+    m_installedBefore = readInstalledVersions(front.installBasePath);
+    m_done.clear();
+    AppInstallerUtility::Result result =
+            m_installerUtility.install(targets, front.verify, front.allowDowngrade, front.allowReInstall, front.installBasePath,
+                std::bind(&IpkBatchInstaller::onProgress, this, std::placeholders::_1),
+                std::bind(&IpkBatchInstaller::onComplete, this, std::placeholders::_1));
+
+    if (result != AppInstallerUtility::SUCCESS) {
+        LOG_ERROR(MSGID_APPINSTALL_FAIL, 1,
+                  PMLOGKS(REASON, "Failed to start batch install"),
+                  "");
+        onComplete(W_EXITCODE(AI_ERR_INTERNAL, 0));
+        return;
+    }
+
+    for (const auto &request : m_running) {
+        if (request.cbStarted)
+            request.cbStarted();
+    }
+}
+
+void IpkBatchInstaller::onProgress(const char *str)
+{
+    std::vector<std::string> words;
+    boost::split(words, str, boost::is_any_of(" \t\n:(),'\""), boost::token_compress_on);
+
+    // package name should be a whole word, "com.a" is a part of "com.a.b"
+    for (const auto &request : m_running) {
+        if (request.packageId.empty())
+            continue;
+        if (std::find(words.begin(), words.end(), request.packageId) == words.end())
+            continue;
+
+        if (words.size() > 1 && words[0] == "status" && words[1] == "done")
+            m_done.insert(request.packageId);
+
+        if (request.cbProgress)
+            request.cbProgress(str);
+        return;
+    }
+
+    if (!isRunStage(str))
+        return;
+
+    // stage line of the run is common for all requests
+    for (const auto &request : m_running) {
+        if (request.cbProgress)
+            request.cbProgress(str);
+    }
+}
+
+void IpkBatchInstaller::onComplete(int status)
+{
+    AppInstaller::instance().releaseOpkg(IPK_BATCH_OWNER);
+
+    // results are decided before callbacks, they might start next run
+    std::vector<int> results(m_running.size(), W_EXITCODE(0, 0));
+    if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0)) {
+        Versions installed;
+        if (!m_running.empty())
+            installed = readInstalledVersions(m_running.front().installBasePath);
+
+        for (size_t i = 0; i < m_running.size(); ++i) {
+            if (!isInstalled(m_running[i], installed))
+                results[i] = status;
+        }
+    }
+
+    // callbacks might request or cancel install, so current run is closed first
+    std::vector<Request> requests;
+    requests.swap(m_running);
+    acquire();
+
+    for (size_t i = 0; i < requests.size(); ++i)
+        requests[i].cbComplete(results[i]);
+}
+
+bool IpkBatchInstaller::isInstalled(const Request &request, const Versions &installed) const
+{
+    auto it = installed.find(request.packageId);
+    if (it == installed.end() || it->second != request.version)
+        return false;
+
+    if (m_done.count(request.packageId))
+        return true;
+
+    // reinstall doesn't change version, it's told only by done line of this run
+    auto before = m_installedBefore.find(request.packageId);
+    return (before == m_installedBefore.end() || before->second != request.version);
+}
+
+IpkBatchInstaller::Versions IpkBatchInstaller::readInstalledVersions(const std::string &installBasePath)
+{
+    Versions versions;
+    std::ifstream file(installBasePath + Settings::instance().getOpkgStatusFilePath());
+    if (!file.good())
+        return versions;
+
+    // stanzas of "Package:", "Version:" and "Status:" fields are split by empty line
+    std::string line, package, version, state;
+    while (true) {
+        bool more = static_cast<bool>(std::getline(file, line));
+        if (!more || line.empty()) {
+            if (!package.empty() && boost::ends_with(state, " installed"))
+                versions[package] = version;
+            package.clear();
+            version.clear();
+            state.clear();
+            if (!more)
+                break;
+            continue;
+        }
+
+        if (boost::starts_with(line, "Package:"))
+            package = boost::trim_copy(line.substr(8));
+        else if (boost::starts_with(line, "Version:"))
+            version = boost::trim_copy(line.substr(8));
+        else if (boost::starts_with(line, "Status:"))
+            state = boost::trim_copy(line.substr(7));
+    }
+
+    return versions;
+}
+
+bool IpkBatchInstaller::isRunStage(const char *str)
+{
+    // "done" and errors are results of one package, they're told by exit status of the run
+    static const std::vector<std::string> RUN_STAGES({
+        "starting",
+        "unpacking",
+        "verifying",
+        "installing"
+    });
+
+    std::vector<std::string> words;
+    boost::split(words, str, boost::is_any_of(" \n"));
+    if (words.size() < 2 || words[0] != "status:")
+        return false;
+
+    return std::find(RUN_STAGES.begin(), RUN_STAGES.end(), words[1]) != RUN_STAGES.end();
+}
+
+bool IpkBatchInstaller::isCompatible(const Request &a, const Request &b)
+{
+    return (a.verify == b.verify &&
+            a.allowDowngrade == b.allowDowngrade &&
+            a.allowReInstall == b.allowReInstall &&
+            a.installBasePath == b.installBasePath);
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPKBATCHINSTALLER_H
+#define IPKBATCHINSTALLER_H
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/Singleton.hpp"
+#include "installer/AppInstallerUtility.h"
+
+/*! IpkBatchInstaller class installs ipks of several tasks by one ApplicationInstallerUtility run.
+ * Requests which arrive while opkg is busy are gathered and installed together when opkg is free,
+ * so opkg startup, lock and status file rewrite are paid once per run instead of once per ipk.
+ *
+ * Progress lines are delivered to the task whose package name is a word of the line,
+ * or to all tasks of the run for common stage lines. Unmatched done or error lines are dropped.
+ *
+ * When the run fails, opkg status file tells which packages are installed with expected version,
+ * so only failed ones are reported as failed.
+ */
+class IpkBatchInstaller : public Singleton<IpkBatchInstaller> {
+public:
+    //! Install request of a task
+    struct Request {
+        std::string appId;
+        std::string packageId;
+        std::string version;
+        std::string ipkFile;
+        bool verify;
+        bool allowDowngrade;
+        bool allowReInstall;
+        std::string installBasePath;
+        //! It's called when the run serving this request is started
+        std::function<void ()> cbStarted;
+        AppInstallerUtility::FuncProgress cbProgress;
+        AppInstallerUtility::FuncComplete cbComplete;
+    };
+
+    //! Request install. cbComplete is called with exit status for the package
+    void install(Request request);
+
+    /*! Cancel request of given appId
+     * Returns false if its run is already started, then cbComplete is called when the run completes
+     */
+    bool cancel(const std::string &appId);
+
+protected:
+friend class Singleton<IpkBatchInstaller>;
+    //! Constructor
+    IpkBatchInstaller();
+
+    //! Destructor
+    ~IpkBatchInstaller();
+
+    //! wait for opkg if there is pending request
+    void acquire();
+
+    //! It's called when opkg is available, start a run for pending requests
+    void onOpkgAcquired();
+
+    //! deliver progress line to requests of current run
+    void onProgress(const char *str);
+
+    //! notify result to requests of current run
+    void onComplete(int status);
+
+    //! package name to version of installed packages in opkg status file
+    typedef std::map<std::string, std::string> Versions;
+
+    //! check package is installed with expected version by current run
+    bool isInstalled(const Request &request, const Versions &installed) const;
+
+    //! read installed packages from opkg status file under installBasePath
+    static Versions readInstalledVersions(const std::string &installBasePath);
+
+    //! check line is a stage of the whole run, not a result of one package
+    static bool isRunStage(const char *str);
+
+    //! check two requests can be installed by one run
+    static bool isCompatible(const Request &a, const Request &b);
+
+private:
+    std::deque<Request> m_pending;
+    std::vector<Request> m_running;
+
+    bool m_waiting;
+    //! installed versions before current run
+    Versions m_installedBefore;
+    //! packages reported as done by current run
+    std::set<std::string> m_done;
+    AppInstallerUtility m_installerUtility;
+};
+
+#endif
@@ -0,0 +1,371 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "IpkReader.h"
+#include "base/Logging.h"
+
+#define AR_MAGIC            "!<arch>\n"
+#define AR_MAGIC_SIZE       8
+#define AR_HEADER_SIZE      60
+#define TAR_BLOCK_SIZE      512
+#define READ_CHUNK_SIZE     16384
+
+namespace {
+
+//! parse fixed width numeric field of ar/tar header
+bool parseNumber(const char *field, size_t size, int base, uint64_t &value)
+{
+    std::string str(field, strnlen(field, size));
+    size_t begin = str.find_first_not_of(' ');
+    if (begin == std::string::npos)
+        return false;
+
+    char *end = nullptr;
+    errno = 0;
+    value = strtoull(str.c_str() + begin, &end, base);
+    if (errno != 0 || end == str.c_str() + begin)
+        return false;
+
+    return true;
+}
+
+//! strip leading "./" of tar entry name
+std::string normalizeName(std::string name)
+{
+    while (name.compare(0, 2, "./") == 0)
+        name.erase(0, 2);
+    return name;
+}
+
+//! Incremental ustar parser fed by decompressed data
+class TarStream {
+public:
+    typedef enum {
+        MORE = 0,
+        STOP,
+        END,
+        ERROR
+    } State;
+
+    explicit TarStream(IpkReader::FuncEntry onEntry)
+        : m_onEntry(std::move(onEntry)),
+          m_inHeader(true),
+          m_remain(0),
+          m_padding(0),
+          m_type(0)
+    {
+    }
+
+    State feed(const char *data, size_t size)
+    {
+        size_t pos = 0;
+
+        while (pos < size) {
+            if (m_inHeader) {
+                size_t need = TAR_BLOCK_SIZE - m_header.size();
+                size_t len = std::min(need, size - pos);
+                m_header.append(data + pos, len);
+                pos += len;
+
+                if (m_header.size() < TAR_BLOCK_SIZE)
+                    break;
+
+                State state = parseHeader();
+                m_header.clear();
+                if (state != MORE)
+                    return state;
+            } else if (m_remain > 0) {
+                size_t len = std::min<uint64_t>(m_remain, size - pos);
+                if (isKept())
+                    m_content.append(data + pos, len);
+                pos += len;
+                m_remain -= len;
+
+                if (m_remain == 0) {
+                    State state = onEntryDone();
+                    if (state != MORE)
+                        return state;
+                }
+            } else {
+                size_t len = std::min<uint64_t>(m_padding, size - pos);
+                pos += len;
+                m_padding -= len;
+                if (m_padding == 0)
+                    m_inHeader = true;
+            }
+        }
+
+        return MORE;
+    }
+
+private:
+    bool isKept() const
+    {
+        // regular file or GNU long name
+        return (m_type == '0' || m_type == '\0' || m_type == 'L');
+    }
+
+    State parseHeader()
+    {
+        const char *header = m_header.data();
+
+        // end of archive is marked by zero blocks
+        if (m_header.find_first_not_of('\0') == std::string::npos)
+            return END;
+
+        uint64_t size = 0;
+        if (!parseNumber(header + 124, 12, 8, size))
+            return ERROR;
+
+        m_type = header[156];
+
+        if (!m_longName.empty()) {
+            m_name = std::move(m_longName);
+            m_longName.clear();
+        } else {
+            m_name.assign(header, strnlen(header, 100));
+            // ustar prefix field
+            if (memcmp(header + 257, "ustar", 5) == 0 && header[345] != '\0')
+                m_name = std::string(header + 345, strnlen(header + 345, 155)) + "/" + m_name;
+        }
+
+        m_content.clear();
+        m_remain = size;
+        m_padding = (TAR_BLOCK_SIZE - (size % TAR_BLOCK_SIZE)) % TAR_BLOCK_SIZE;
+        m_inHeader = false;
+
+        if (m_remain == 0)
+            return onEntryDone();
+
+        return MORE;
+    }
+
+    State onEntryDone()
+    {
+        if (m_padding == 0)
+            m_inHeader = true;
+
+        if (m_type == 'L') {
+            m_longName.assign(m_content.c_str());
+            return MORE;
+        }
+
+        if (!isKept())
+            return MORE;
+
+        if (!m_onEntry(normalizeName(m_name), m_content))
+            return STOP;
+
+        return MORE;
+    }
+
+    IpkReader::FuncEntry m_onEntry;
+
+    std::string m_header;
+    bool m_inHeader;
+    uint64_t m_remain;
+    uint64_t m_padding;
+
+    char m_type;
+    std::string m_name;
+    std::string m_longName;
+    std::string m_content;
+};
+
+}
+
+IpkReader::IpkReader()
+    : m_fd(-1)
+{
+}
+
+IpkReader::~IpkReader()
+{
+    close();
+}
+
+bool IpkReader::open(const std::string &path)
+{
+    close();
+
+    m_path = path;
+    m_error.clear();
+
+    m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (m_fd == -1)
+        return setError(std::string("unable to open file: ") + strerror(errno));
+
+    return true;
+}
+
+void IpkReader::close()
+{
+    if (m_fd != -1) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+bool IpkReader::seekMember(const std::string &member, uint64_t &size)
+{
+    if (m_fd == -1)
+        return setError("file is not opened");
+
+    if (lseek(m_fd, 0, SEEK_SET) == -1)
+        return setError(std::string("unable to seek: ") + strerror(errno));
+
+    char magic[AR_MAGIC_SIZE];
+    if (read(m_fd, magic, AR_MAGIC_SIZE) != AR_MAGIC_SIZE || memcmp(magic, AR_MAGIC, AR_MAGIC_SIZE) != 0)
+        return setError("not an ar archive");
+
+    char header[AR_HEADER_SIZE];
+    while (true) {
+        ssize_t len = read(m_fd, header, AR_HEADER_SIZE);
+        if (len == 0)
+            break;
+        if (len != AR_HEADER_SIZE || header[58] != '`' || header[59] != '\n')
+            return setError("corrupted ar header");
+
+        std::string name(header, 16);
+        name.erase(name.find_last_not_of(' ') + 1);
+        if (!name.empty() && name.back() == '/')
+            name.pop_back();
+
+        uint64_t memberSize = 0;
+        if (!parseNumber(header + 48, 10, 10, memberSize))
+            return setError("corrupted ar header");
+
+        if (name == member) {
+            size = memberSize;
+            return true;
+        }
+
+        // member data is aligned to even byte
+        off_t skip = memberSize + (memberSize & 1);
+        if (lseek(m_fd, skip, SEEK_CUR) == -1)
+            return setError(std::string("unable to seek: ") + strerror(errno));
+    }
+
+    return setError(member + " is not found");
+}
+
+bool IpkReader::readEntries(const std::string &member, FuncEntry onEntry)
+{
+    uint64_t remain = 0;
+    if (!seekMember(member, remain))
+        return false;
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // 16 + MAX_WBITS : gzip header
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK)
+        return setError("unable to initialize zlib");
+
+    TarStream tar(std::move(onEntry));
+    TarStream::State state = TarStream::MORE;
+    char in[READ_CHUNK_SIZE];
+    char out[READ_CHUNK_SIZE];
+    int zresult = Z_OK;
+    // inflate filled whole output buffer, it may have more without new input
+    bool pending = false;
+
+    while (state == TarStream::MORE && zresult != Z_STREAM_END) {
+        if (stream.avail_in == 0 && !pending) {
+            if (remain == 0)
+                break;
+
+            ssize_t len = read(m_fd, in, std::min<uint64_t>(remain, READ_CHUNK_SIZE));
+            if (len <= 0) {
+                inflateEnd(&stream);
+                return setError(member + " is truncated");
+            }
+
+            remain -= len;
+            stream.next_in = reinterpret_cast<Bytef*>(in);
+            stream.avail_in = len;
+        }
+
+        stream.next_out = reinterpret_cast<Bytef*>(out);
+        stream.avail_out = READ_CHUNK_SIZE;
+
+        zresult = inflate(&stream, Z_NO_FLUSH);
+        // Z_BUF_ERROR only means no progress, e.g. output was already drained
+        if (zresult != Z_OK && zresult != Z_STREAM_END && zresult != Z_BUF_ERROR) {
+            inflateEnd(&stream);
+            return setError(member + " is not a valid gzip stream");
+        }
+
+        pending = (stream.avail_out == 0);
+        state = tar.feed(out, READ_CHUNK_SIZE - stream.avail_out);
+    }
+
+    inflateEnd(&stream);
+
+    if (state == TarStream::ERROR)
+        return setError(member + " is not a valid tar archive");
+
+    // neither gzip stream nor tar archive ended, member was cut
+    if (state == TarStream::MORE && zresult != Z_STREAM_END)
+        return setError(member + " is truncated");
+
+    return true;
+}
+
+bool IpkReader::readFile(const std::string &member, const std::string &fileName, std::string &content)
+{
+    bool found = false;
+
+    bool result = readEntries(member, [&] (const std::string &name, const std::string &data) -> bool {
+        if (name != fileName)
+            return true;
+
+        content = data;
+        found = true;
+        return false;
+    });
+
+    if (!result)
+        return false;
+
+    if (!found)
+        return setError(fileName + " is not found in " + member);
+
+    return true;
+}
+
+const std::string& IpkReader::getError() const
+{
+    return m_error;
+}
+
+bool IpkReader::setError(const std::string &errorText)
+{
+    m_error = errorText;
+
+    LOG_WARNING(MSGID_APPUNPACK_IPK_FAIL, 2,
+                PMLOGKS(FILENAME, m_path.c_str()),
+                PMLOGKS(LOGKEY_ERRTEXT, m_error.c_str()),
+                "Failed to read ipk file");
+
+    return false;
+}
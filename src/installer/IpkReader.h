@@ -0,0 +1,70 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPKREADER_H
+#define IPKREADER_H
+
+#include <functional>
+#include <stdint.h>
+#include <string>
+
+/*! IpkReader class reads ipk file(ar archive of gzip'd tar members) in process.
+ * Members are located by walking ar header table and only requested member is
+ * decompressed as a stream, so nothing is written to disk and no child process is needed.
+ * Regular files are returned in memory, so it's meant for small members like control.tar.gz
+ */
+class IpkReader {
+public:
+    //! It's called for each regular file in tar member. Return false to stop reading
+    typedef std::function<bool (const std::string &name, const std::string &content)> FuncEntry;
+
+    //! Constructor
+    IpkReader();
+
+    //! Destructor
+    ~IpkReader();
+
+    //! Open ipk file
+    bool open(const std::string &path);
+
+    //! Close ipk file
+    void close();
+
+    /*! Find member in ar archive and move file offset to its data.
+     * Data of other members are skipped with lseek, not read.
+     */
+    bool seekMember(const std::string &member, uint64_t &size);
+
+    //! Read regular files of gzip'd tar member
+    bool readEntries(const std::string &member, FuncEntry onEntry);
+
+    //! Read one file of gzip'd tar member to content
+    bool readFile(const std::string &member, const std::string &fileName, std::string &content);
+
+    //! Get last error text
+    const std::string& getError() const;
+
+protected:
+    //! set error text and log it
+    bool setError(const std::string &errorText);
+
+private:
+    int m_fd;
+    std::string m_path;
+    std::string m_error;
+};
+
+#endif
@@ -15,6 +15,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "base/Logging.h"
+#include "base/Tracing.h"
 #include "settings/Settings.h"
 #include "Jailer.h"
 
@@ -44,6 +45,7 @@ bool Jailer::remove(std::string appId, std::function<void(bool)> onRemove)
                            &gerr);
 
     if (result) {
+        Tracing::childStarted(childPid, "jailer remove", appId);
         g_child_watch_add(childPid, cbRemoveComplete, this);
         m_funcComplete = std::move(onRemove);
 
@@ -65,6 +67,7 @@ bool Jailer::remove(std::string appId, std::function<void(bool)> onRemove)
 void Jailer::cbRemoveComplete(GPid pid, gint status, gpointer user_data)
 {
     LOG_DEBUG("child pid %d removed jailer directories with status %d", pid, status);
+    Tracing::childExited(pid);
 
     Jailer *jailer = reinterpret_cast<Jailer*>(user_data);
     if (!jailer)
@@ -29,7 +29,7 @@ bool Manifest::isLoaded() const
 
 bool Manifest::load(const std::string& path)
 {
-    m_info = JUtil::parseFile(path, std::string(""));
+    m_info = JUtil::parseFileTrusted(path);
     if (m_info.isNull())
         return false;
 
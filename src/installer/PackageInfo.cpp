@@ -60,7 +60,7 @@ std::string PackageInfo::getVersion() const
 bool PackageInfo::load()
 {
     std::string path = m_packagePath + "/packageinfo.json";
-    m_info = JUtil::parseFile(path, std::string(""));
+    m_info = JUtil::parseFileTrusted(path);
 
     if (m_info.isNull())
         return false;
@@ -109,7 +109,7 @@ bool ServiceInfo::load()
 {
     std::string path = m_servicePath + "/services.json";
     LOG_DEBUG("[ServiceInfo::load]  path: %s ",path.c_str());
-    m_info = JUtil::parseFile(path, std::string(""));
+    m_info = JUtil::parseFileTrusted(path);
 
     if (m_info.isNull())
         return false;
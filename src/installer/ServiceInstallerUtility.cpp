@@ -23,6 +23,7 @@
 #include "base/Logging.h"
 #include "base/Utils.h"
 #include "base/System.h"
+#include "base/Tracing.h"
 #include "installer/CallChainEventHandler.h"
 #include "PackageInfo.h"
 #include "ServiceInfo.h"
@@ -87,7 +88,10 @@ bool ServiceInstallerUtility::install(std::string appId,
         packageInfo.getServices(serviceLists);
 
     // generate Manifest file
-    if (!ServiceInstallerUtility::generateManifestFile(pathInfo, installBasePath, packageInfo, appInfo)) {
+    Tracing::begin("generate manifest", appId);
+    bool generated = ServiceInstallerUtility::generateManifestFile(pathInfo, installBasePath, packageInfo, appInfo);
+    Tracing::end("generate manifest", appId);
+    if (!generated) {
         Utils::async([onComplete = std::move(onComplete)]() {onComplete(false, "Failed to generate Manifest file");});
         return false;
     }
@@ -114,6 +118,7 @@ bool ServiceInstallerUtility::install(std::string appId,
           return false;
         }
 
+        Tracing::Span span("generate service files", serviceInfo.getId());
         if (!generateFilesForService(pathInfo, serviceInfo, appInfo)) {
           Utils::async([onComplete = std::move(onComplete)]() {onComplete(false, "Failed to generate service files");});
           return false;
@@ -121,6 +126,7 @@ bool ServiceInstallerUtility::install(std::string appId,
     }
 
     // native app has default role file
+    Tracing::Span span("generate app files", appId);
     if (appInfo.isNative()) {
         if (!generateRoleFileForNativeApp(pathInfo.roled, appInfo.getId(), appInfo.getMain(true)) ||
             !generatePermissionFileForNativeApp(pathInfo.permissiond, pathInfo.verified, appInfo, serviceLists)) {
@@ -219,6 +225,7 @@ bool ServiceInstallerUtility::remove(std::string appId,
 
 bool ServiceInstallerUtility::removeOne(const std::string &appId, const PathInfo &pathInfo)
 {
+    Tracing::Span span("remove service files", appId);
     std::string manifestPath = pathInfo.manifestsd + "/" + appId + ".json";
 
     LOG_DEBUG("[ServiceInstallerUtility] remove luna manifest file : %s", manifestPath.c_str());
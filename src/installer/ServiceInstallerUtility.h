@@ -54,6 +54,9 @@ public:
     static bool remove(std::string appId, const PathInfos &pathInfos, std::function<void(bool, std::string)> onComplete);
 
 private:
+    //! tests and benchmarks reach private generators through it
+    friend class ServiceInstallerUtilityTest;
+
     static bool onUpdateManifest(pbnjson::JValue result, void *user_data, std::function<void(bool, std::string)> onComplete);
     static bool onRemoveManifest(pbnjson::JValue result, void *user_data, const std::string &appId, const PathInfos &pathInfos,
                                  std::function<void(bool, std::string)> onComplete);
@@ -0,0 +1,102 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "SmackApplier.h"
+#include "base/Logging.h"
+#include "base/Tracing.h"
+#include "base/Utils.h"
+#include "settings/Settings.h"
+#include "settings/Smack.h"
+
+SmackApplier::SmackApplier()
+    : m_scheduled(false),
+      m_pid(-1)
+{
+}
+
+SmackApplier::~SmackApplier()
+{
+}
+
+void SmackApplier::apply(FuncApplied onApplied)
+{
+    m_pending.push_back(std::move(onApplied));
+
+    // running one can't serve this request, rules might be written after it started.
+    // it'll be scheduled again when running one completes
+    if (m_scheduled || m_pid != -1)
+        return;
+
+    m_scheduled = true;
+    Utils::async([this] { run(); }, SMACK_APPLY_DELAY);
+}
+
+void SmackApplier::run()
+{
+    m_scheduled = false;
+    m_running.swap(m_pending);
+
+    gchar *argv[] = { (gchar *)Settings::instance().getSmackctlPath().c_str(), (gchar *)"apply", NULL };
+    GError *gerr = NULL;
+    GSpawnFlags flags = (GSpawnFlags)(G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD);
+
+    LOG_DEBUG("Executing %s %s for %zu requests", argv[0], argv[1], m_running.size());
+
+    if (!g_spawn_async(NULL, argv, NULL, flags, NULL, NULL, &m_pid, &gerr)) {
+        LOG_ERROR(MSGID_EXEC_FAIL, 2,
+                  PMLOGKS(REASON, "Failed to execute smackctl"),
+                  PMLOGKS(LOGKEY_ERRTEXT, gerr ? gerr->message : ""),
+                  "");
+        if (gerr)
+            g_error_free(gerr);
+
+        m_pid = -1;
+        complete(false);
+        return;
+    }
+
+    Tracing::childStarted(m_pid, "smackctl apply", std::string());
+    g_child_watch_add(m_pid, cbComplete, this);
+}
+
+void SmackApplier::complete(bool result)
+{
+    std::vector<FuncApplied> requests;
+    requests.swap(m_running);
+
+    for (auto &onApplied : requests)
+        onApplied(result);
+
+    if (!m_pending.empty() && !m_scheduled) {
+        m_scheduled = true;
+        Utils::async([this] { run(); }, SMACK_APPLY_DELAY);
+    }
+}
+
+void SmackApplier::cbComplete(GPid pid, gint status, gpointer user_data)
+{
+    Tracing::childExited(pid);
+    g_spawn_close_pid(pid);
+
+    SmackApplier *applier = reinterpret_cast<SmackApplier*>(user_data);
+    if (!applier)
+        return;
+
+    LOG_DEBUG("smackctl exit status is %d", (int)WEXITSTATUS(status));
+
+    applier->m_pid = -1;
+    applier->complete(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+}
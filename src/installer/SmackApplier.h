@@ -0,0 +1,62 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SMACKAPPLIER_H
+#define SMACKAPPLIER_H
+
+#include <functional>
+#include <glib.h>
+#include <vector>
+
+#include "base/Singleton.hpp"
+
+/*! SmackApplier class runs "smackctl apply" on behalf of all tasks.
+ * smackctl reloads every rule file, so requests which arrive close together
+ * or while it's running are served by one (next) run.
+ */
+class SmackApplier : public Singleton<SmackApplier> {
+public:
+    typedef std::function<void (bool)> FuncApplied;
+
+    //! Request reloading SMACK rules. onApplied is called with result of the run serving it
+    void apply(FuncApplied onApplied);
+
+protected:
+friend class Singleton<SmackApplier>;
+    //! Constructor
+    SmackApplier();
+
+    //! Destructor
+    ~SmackApplier();
+
+    //! run smackctl for pending requests
+    void run();
+
+    //! notify result to requests served by current run
+    void complete(bool result);
+
+    //! watch function for child complete
+    static void cbComplete(GPid pid, gint status, gpointer user_data);
+
+private:
+    std::vector<FuncApplied> m_pending;
+    std::vector<FuncApplied> m_running;
+
+    bool m_scheduled;
+    GPid m_pid;
+};
+
+#endif
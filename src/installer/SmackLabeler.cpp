@@ -0,0 +1,183 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <atomic>
+#include <dirent.h>
+#include <errno.h>
+#include <ftw.h>
+#include <mutex>
+#include <string.h>
+#include <sys/xattr.h>
+#include <thread>
+#include <vector>
+
+#include "SmackLabeler.h"
+#include "base/Logging.h"
+
+namespace {
+
+//! nftw callback has no user data, so walking state is kept per thread
+struct WalkContext {
+    const SmackLabeler *labeler;
+    std::string errorText;
+};
+
+thread_local WalkContext *t_walkContext = nullptr;
+
+int cbWalk(const char *path, const struct stat *sb, int typeflag, struct FTW *ftwbuf)
+{
+    if (typeflag == FTW_NS || typeflag == FTW_DNR) {
+        t_walkContext->errorText = std::string("unable to access ") + path;
+        return 1;
+    }
+
+    if (!t_walkContext->labeler->labelFile(path, sb, t_walkContext->errorText))
+        return 1;
+
+    return 0;
+}
+
+}
+
+SmackLabeler::SmackLabeler(std::string access,
+                           bool transmute,
+                           std::string exec,
+                           int jobs,
+                           std::string xattrPrefix)
+    : m_access(std::move(access)),
+      m_transmute(transmute),
+      m_exec(std::move(exec)),
+      m_jobs(std::max(1, jobs)),
+      m_accessAttr(xattrPrefix + "SMACK64"),
+      m_transmuteAttr(xattrPrefix + "SMACK64TRANSMUTE"),
+      m_execAttr(xattrPrefix + "SMACK64EXEC")
+{
+}
+
+bool SmackLabeler::labelFile(const char *path, const struct stat *sb, std::string &errorText) const
+{
+    if (lsetxattr(path, m_accessAttr.c_str(), m_access.c_str(), m_access.size(), 0) != 0) {
+        // only security attributes can be set on symbolic link
+        if (S_ISLNK(sb->st_mode) && errno == EPERM)
+            return true;
+
+        errorText = std::string("unable to set ") + m_accessAttr + " of " + path + ": " + strerror(errno);
+        return false;
+    }
+
+    if (m_transmute && S_ISDIR(sb->st_mode) &&
+        lsetxattr(path, m_transmuteAttr.c_str(), "TRUE", 4, 0) != 0) {
+        errorText = std::string("unable to set ") + m_transmuteAttr + " of " + path + ": " + strerror(errno);
+        return false;
+    }
+
+    // exec label is used only when file is executed
+    if (!m_exec.empty() && S_ISREG(sb->st_mode) &&
+        lsetxattr(path, m_execAttr.c_str(), m_exec.c_str(), m_exec.size(), 0) != 0) {
+        errorText = std::string("unable to set ") + m_execAttr + " of " + path + ": " + strerror(errno);
+        return false;
+    }
+
+    return true;
+}
+
+bool SmackLabeler::labelTree(const std::string &path, std::string &errorText) const
+{
+    WalkContext context = { this, std::string() };
+    t_walkContext = &context;
+
+    int result = nftw(path.c_str(), cbWalk, 16, FTW_PHYS);
+    t_walkContext = nullptr;
+
+    if (result != 0) {
+        errorText = context.errorText.empty() ? std::string("unable to walk ") + path : context.errorText;
+        return false;
+    }
+
+    return true;
+}
+
+bool SmackLabeler::label(const std::string &path, std::string &errorText) const
+{
+    struct stat sb;
+    if (lstat(path.c_str(), &sb) != 0) {
+        errorText = std::string("unable to access ") + path + ": " + strerror(errno);
+        return false;
+    }
+
+    if (!S_ISDIR(sb.st_mode) || m_jobs == 1)
+        return labelTree(path, errorText);
+
+    if (!labelFile(path.c_str(), &sb, errorText))
+        return false;
+
+    // label top level files here and give sub directories to workers
+    DIR *dir = opendir(path.c_str());
+    if (!dir) {
+        errorText = std::string("unable to open ") + path + ": " + strerror(errno);
+        return false;
+    }
+
+    std::vector<std::string> subdirs;
+    bool result = true;
+    struct dirent *entry;
+    while (result && (entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
+
+        std::string entryPath = path + "/" + entry->d_name;
+        if (lstat(entryPath.c_str(), &sb) != 0) {
+            errorText = std::string("unable to access ") + entryPath + ": " + strerror(errno);
+            result = false;
+        } else if (S_ISDIR(sb.st_mode)) {
+            subdirs.push_back(std::move(entryPath));
+        } else {
+            result = labelFile(entryPath.c_str(), &sb, errorText);
+        }
+    }
+    closedir(dir);
+
+    if (!result)
+        return false;
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::mutex errorLock;
+
+    auto worker = [&] {
+        size_t index;
+        while (!failed && (index = next++) < subdirs.size()) {
+            std::string workerError;
+            if (!labelTree(subdirs[index], workerError)) {
+                std::lock_guard<std::mutex> lock(errorLock);
+                if (!failed.exchange(true))
+                    errorText = std::move(workerError);
+            }
+        }
+    };
+
+    size_t jobs = std::min<size_t>(m_jobs, subdirs.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < jobs; ++i)
+        threads.emplace_back(worker);
+    worker();
+
+    for (auto &thread : threads)
+        thread.join();
+
+    return !failed;
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SMACKLABELER_H
+#define SMACKLABELER_H
+
+#include <string>
+#include <sys/stat.h>
+
+#include "settings/Smack.h"
+
+/*! SmackLabeler class labels directory tree in process, same as "chsmack -r -a access [-t] [-e exec] path".
+ * Sub directories of given path are walked in parallel by up to jobs threads.
+ * Attributes are named xattrPrefix + "SMACK64*", so it can be run with "user." attributes
+ * on filesystems without SMACK (e.g. tmpfs) as well.
+ */
+class SmackLabeler {
+public:
+    //! Constructor
+    SmackLabeler(std::string access,
+                 bool transmute,
+                 std::string exec = "",
+                 int jobs = SMACK_LABEL_JOBS,
+                 std::string xattrPrefix = SMACK_XATTR_PREFIX);
+
+    //! Label path and all files under it. It blocks, so call it from worker thread
+    bool label(const std::string &path, std::string &errorText) const;
+
+    //! Label one file
+    bool labelFile(const char *path, const struct stat *sb, std::string &errorText) const;
+
+protected:
+    //! Label all files under path
+    bool labelTree(const std::string &path, std::string &errorText) const;
+
+private:
+    std::string m_access;
+    bool m_transmute;
+    std::string m_exec;
+    int m_jobs;
+
+    std::string m_accessAttr;
+    std::string m_transmuteAttr;
+    std::string m_execAttr;
+};
+
+#endif
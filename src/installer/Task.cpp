@@ -16,38 +16,32 @@
 
 #include "Task.h"
 
+#include <algorithm>
 #include <cinttypes>
 
-#include "base/Creator.h"
-#include "base/Factory.h"
+#include "base/JUtil.h"
 #include "base/Logging.h"
 #include "base/SessionList.h"
+#include "base/Tracing.h"
 #include "base/Utils.h"
 #include "client/ApplicationManager.h"
 #include "settings/Settings.h"
-#include "step/AppCloseStep.h"
-#include "step/DataRemoveStep.h"
-#include "step/GetIpkInfoStep.h"
-#include "step/IpkInstallStep.h"
-#include "step/IpkParseStep.h"
-#include "step/UnpackagedInstallStep.h"
-#include "step/IpkRemoveStep.h"
-#include "step/InstallSmackStep.h"
-#include "step/RemoveJailStep.h"
-#include "step/RemoveSmackStep.h"
-#include "step/RemoveStartStep.h"
-#include "step/ServiceInstallStep.h"
-#include "step/ServiceUninstallStep.h"
-
-typedef Factory<Step> StepFactory;
 
 Task::Task()
         : m_errorCode(0),
           m_step(Unknown),
+          m_registry(nullptr),
           m_finished(false),
           m_run(false),
+          m_canceled(false),
+          m_isPWA(false),
           m_hasInstalledSizeWithControlFile(false),
           m_unpackFileSize(0),
+          m_progress(0),
+          m_statusDirty(true),
+          m_createdTime(g_get_monotonic_time()),
+          m_runTime(0),
+          m_tracedStep(Undefied),
           m_packFileSize(0),
           m_unpacked(false),
           m_allowReInstall(false),
@@ -86,24 +80,8 @@ bool Task::initialize(pbnjson::JValue param)
         LOG_DEBUG("Task::initialize()  PackageId %s \n", m_appId.c_str());
         setPackageId(m_appId);
 
-        StepFactory::instance().registerObject("IpkInstallNeeded", CreatorUsingNew<UnpackagedInstallStep>());
+        m_isPWA = true;
     }
-    else
-    {
-        StepFactory::instance().registerObject("IpkInstallNeeded", CreatorUsingNew<IpkInstallStep>());
-    }
-
-    StepFactory::instance().registerObject("IpkParseNeeded", CreatorUsingNew<IpkParseStep>());
-    StepFactory::instance().registerObject("GetIpkInfoNeeded", CreatorUsingNew<GetIpkInfoStep>());
-    StepFactory::instance().registerObject("AppCloseNeeded", CreatorUsingNew<AppCloseStep>());
-    StepFactory::instance().registerObject("InstallSmackNeeded", CreatorUsingNew<InstallSmackStep>());
-    StepFactory::instance().registerObject("ServiceInstallNeeded", CreatorUsingNew<ServiceInstallStep>());
-    StepFactory::instance().registerObject("RemoveNeeded", CreatorUsingNew<RemoveStartStep>());
-    StepFactory::instance().registerObject("RemoveJailNeeded", CreatorUsingNew<RemoveJailStep>());
-    StepFactory::instance().registerObject("ServiceUninstallNeeded", CreatorUsingNew<ServiceUninstallStep>());
-    StepFactory::instance().registerObject("IpkRemoveNeeded", CreatorUsingNew<IpkRemoveStep>());
-    StepFactory::instance().registerObject("DataRemoveNeeded", CreatorUsingNew<DataRemoveStep>());
-    StepFactory::instance().registerObject("RemoveSmackNeeded", CreatorUsingNew<RemoveSmackStep>());
 
     return true;
 }
@@ -126,8 +104,9 @@ bool Task::onAccept(pbnjson::JValue param)
 bool Task::run()
 {
     m_run = true;
+    m_runTime = g_get_monotonic_time();
     Utils::async([=] {
-        //signalStarted(*this);
+        signalStarted(*this);
         LOG_DEBUG("Task::run\n");
         proceed();
     });
@@ -144,6 +123,8 @@ void Task::setStep(TaskStep step, bool forceSet)
         return;
 
     m_step = step;
+    m_statusDirty = true;
+    m_stepTimes.emplace_back(step, g_get_monotonic_time());
     signalStatusChanged(*this);
 }
 
@@ -151,6 +132,7 @@ void Task::setError(TaskStep status, int errorCode, std::string errorText)
 {
     m_errorCode = errorCode;
     m_errorText = errorText;
+    m_statusDirty = true;
 
     LOG_ERROR(MSGID_TASK_ERROR, 3,
               PMLOGKS(APP_ID, getAppId().c_str()),
@@ -160,6 +142,7 @@ void Task::setError(TaskStep status, int errorCode, std::string errorText)
 
     switch (status) {
         case ErrorInstall:
+        case InstallCanceled:
             //remove installDataPath for removing control files
             Utils::remove_dir(m_installBasePath + "/tmp/" + m_appId);
             break;
@@ -178,6 +161,7 @@ std::vector<std::string>& Task::getServices()
 void Task::setPackageId(std::string packageId)
 {
     m_packageId = std::move(packageId);
+    m_statusDirty = true;
 }
 
 std::string Task::getPackageId() const
@@ -185,6 +169,16 @@ std::string Task::getPackageId() const
     return m_packageId;
 }
 
+void Task::setPackageVersion(std::string packageVersion)
+{
+    m_packageVersion = std::move(packageVersion);
+}
+
+std::string Task::getPackageVersion() const
+{
+    return m_packageVersion;
+}
+
 void Task::setFilesize(uint64_t packFileSize, uint64_t unpackFileSize)
 {
     m_packFileSize = packFileSize;
@@ -201,6 +195,22 @@ void Task::setUnpackFilesize(uint64_t unpackFileSize)
     m_unpackFileSize = unpackFileSize;
 }
 
+void Task::setProgress(int progress)
+{
+    progress = std::max(0, std::min(100, progress));
+    if (m_finished || progress == m_progress)
+        return;
+
+    m_progress = progress;
+    m_statusDirty = true;
+    signalStatusChanged(*this);
+}
+
+int Task::getProgress() const
+{
+    return m_progress;
+}
+
 void Task::setHasInstalledSizeWithControlFile(bool hasSizeInCtrFile)
 {
     m_hasInstalledSizeWithControlFile = hasSizeInCtrFile;
@@ -217,6 +227,7 @@ void Task::setOriginAppInfo(pbnjson::JValue appInfo)
 void Task::setInstallBasePath(std::string installBasePath)
 {
     m_installBasePath = std::move(installBasePath);
+    m_statusDirty = true;
 }
 
 //! get InstallBasePath
@@ -291,9 +302,25 @@ std::string Task::getName() const
     return m_name;
 }
 
+int64_t Task::getCreatedTime() const
+{
+    return m_createdTime;
+}
+
+int64_t Task::getRunTime() const
+{
+    return m_runTime;
+}
+
+const Task::StepTimes& Task::getStepTimes() const
+{
+    return m_stepTimes;
+}
+
 pbnjson::JValue Task::toJValue() const
 {
-    pbnjson::JValue json = getAppInfo();
+    // appInfo is shared with task, so status is built on its copy
+    pbnjson::JValue json = getAppInfo().duplicate();
     json.put("statusValue", (int) getStep());
 
     pbnjson::JValue details = json["details"];
@@ -313,17 +340,6 @@ pbnjson::JValue Task::toJValue() const
         details.put("installBasePath", m_installBasePath);
 
     TaskStep step = getStep();
-    if (step == InstallComplete) {
-        LOG_NORMAL(MSGID_APP_INSTALLED, 2,
-                   PMLOGKS(APP_ID, getAppId().c_str()),
-                   PMLOGKS(CALLER, json["details"]["client"].asString().c_str()),
-                   "");
-    } else if (step == RemoveComplete) {
-        LOG_INFO(MSGID_APP_REMOVED, 2,
-                 PMLOGKS(APP_ID, getAppId().c_str()),
-                 PMLOGKS(CALLER, json["details"]["client"].asString().c_str()),
-                 "");
-    }
 
     //TODO : Move details definition to installHistory.h
     switch (step) {
@@ -362,6 +378,12 @@ pbnjson::JValue Task::toJValue() const
             details.put("progress", 100);
             break;
 
+        case InstallCanceled:
+            details.put("state", "install canceled");
+            details.put("errorCode", getErrorCode());
+            details.put("reason", getErrorText());
+            break;
+
         case ErrorInstall:
             details.put("state", "install failed");
             details.put("errorCode", getErrorCode());
@@ -430,18 +452,38 @@ pbnjson::JValue Task::toJValue() const
             break;
     }
 
+    // measured by IpkInstallStep while opkg is unpacking
+    if (step >= IpkInstallRequested && step <= IpkInstallComplete)
+        details.put("progress", m_progress);
+
     return json;
 }
 
+const std::string& Task::getStatusString() const
+{
+    if (m_statusDirty) {
+        pbnjson::JValue json = toJValue();
+        m_statusCache = json.isNull() ? std::string() : JUtil::toSimpleString(std::move(json));
+        m_statusDirty = false;
+    }
+
+    return m_statusCache;
+}
+
 bool Task::isError() const
 {
     return (0 != m_errorCode);
 }
 
-bool Task::prepareStep(std::map<TaskStep, TaskStep> mapStep)
+bool Task::prepareStep(const StepSettings::StepRegistry *registry)
 {
-    m_mapStep = std::move(mapStep);
-    return true;
+    m_registry = registry;
+    return (m_registry != nullptr);
+}
+
+bool Task::isPWA() const
+{
+    return m_isPWA;
 }
 
 void Task::finish()
@@ -450,29 +492,41 @@ void Task::finish()
         return;
 
     // TODO unlock app
+    // task canceled in queue never ran any step, so app was never locked
+    if (m_run) {
 #if defined(ENABLE_SESSION)
-    size_t size = SessionList::getInstance().size();
-    for (size_t i = 0; i < size; ++i) {
-        const std::string& sessionId = SessionList::getInstance().at(i);
-        ApplicationManager::getInstance().lockApp(sessionId.c_str(), getPackageId(), false);
-    }
+        size_t size = SessionList::getInstance().size();
+        for (size_t i = 0; i < size; ++i) {
+            const std::string& sessionId = SessionList::getInstance().at(i);
+            ApplicationManager::getInstance().lockApp(sessionId.c_str(), getPackageId(), false);
+        }
 #else
-    ApplicationManager::getInstance().lockApp(nullptr, getPackageId(), false);
+        ApplicationManager::getInstance().lockApp(nullptr, getPackageId(), false);
 #endif
+    }
 
     signalFinished(*this);
     m_currentStep = nullptr;
     m_finished = true;
+    endStepTrace();
 }
 
 bool Task::proceed()
 {
-    TaskStepParser parser;
     if (m_finished)
         return true;
 
-    std::map<TaskStep, TaskStep>::iterator it = m_mapStep.find(m_step);
-    if (it == m_mapStep.end()) {
+    if (m_canceled) {
+        setError(InstallCanceled, APP_INSTALL_ERR_CANCELED, "install is canceled");
+        LOG_INFO(MSGID_APP_INSTALL_CANCELED, 1,
+                 PMLOGKS(APP_ID, getAppId().c_str()),
+                 "");
+        finish();
+        return false;
+    }
+
+    TaskStep next = m_registry ? m_registry->getNextStep(m_step) : Undefied;
+    if (next == Undefied) {
         LOG_WARNING(MSGID_STATUS_CHANGE_UNDEFINED, 2,
                     PMLOGKS(APP_ID, getAppId().c_str()),
                     PMLOGKFV(STATUS,"%d",m_step),
@@ -481,7 +535,7 @@ bool Task::proceed()
         return false;
     }
 
-    setStep(it->second);
+    setStep(next);
     bool success = onProceed(m_step);
     if (!success)
         finish();
@@ -489,17 +543,92 @@ bool Task::proceed()
     return success;
 }
 
+bool Task::isCheckpoint() const
+{
+    if (m_step == Unknown || !m_registry)
+        return false;
+
+    return (m_registry->getNextStep(m_step) != Undefied);
+}
+
+pbnjson::JValue Task::getCheckpoint() const
+{
+    pbnjson::JValue services = pbnjson::Array();
+    for (const auto &service : m_services)
+        services.append(service);
+
+    pbnjson::JValue checkpoint = pbnjson::Object();
+    checkpoint.put("step", (int) m_step);
+    checkpoint.put("packageId", m_packageId);
+    checkpoint.put("packageVersion", m_packageVersion);
+    checkpoint.put("installBasePath", m_installBasePath);
+    checkpoint.put("unpackFileSize", (int64_t) m_unpackFileSize);
+    checkpoint.put("allowReInstall", m_allowReInstall);
+    checkpoint.put("services", services);
+    if (!m_originAppInfo.isNull())
+        checkpoint.put("originAppInfo", m_originAppInfo);
+
+    return checkpoint;
+}
+
+void Task::resume(pbnjson::JValue checkpoint)
+{
+    if (m_run)
+        return;
+
+    m_step = (TaskStep) checkpoint["step"].asNumber<int>();
+    m_packageId = checkpoint["packageId"].asString();
+    m_packageVersion = checkpoint["packageVersion"].asString();
+    m_installBasePath = checkpoint["installBasePath"].asString();
+    m_unpackFileSize = checkpoint["unpackFileSize"].asNumber<int64_t>();
+    m_allowReInstall = checkpoint["allowReInstall"].asBool();
+
+    m_services.clear();
+    for (int i = 0; i < checkpoint["services"].arraySize(); ++i)
+        m_services.push_back(checkpoint["services"][i].asString());
+
+    if (checkpoint.hasKey("originAppInfo"))
+        setOriginAppInfo(checkpoint["originAppInfo"]);
+
+    m_statusDirty = true;
+}
+
+bool Task::cancel()
+{
+    if (m_finished || m_canceled)
+        return false;
+
+    m_canceled = true;
+
+    // not started yet, or current step has stopped its work
+    if (!m_currentStep || m_currentStep->cancel())
+        proceed();
+
+    return true;
+}
+
+bool Task::isCanceled() const
+{
+    return m_canceled;
+}
+
 std::shared_ptr<Step> Task::createStep(TaskStep step)
 {
-    TaskStepParser parser;
-    auto stepTask = StepFactory::instance().create(parser.enumToStringStep(step));
-    return stepTask;
+    if (!m_registry)
+        return nullptr;
+
+    return m_registry->createStep(step);
 }
 
 bool Task::onProceed(TaskStep step)
 {
-    TaskStepParser parser;
     bool success = false;
+
+    // step span lasts until next step is proceeded or task is finished
+    endStepTrace();
+    m_tracedStep = step;
+    Tracing::begin(TaskStepParser::enumToStringStep(step).c_str(), m_appId);
+
     m_currentStep = createStep(step);
     if (!m_currentStep) {
         return false;
@@ -510,3 +639,11 @@ bool Task::onProceed(TaskStep step)
     return success;
 }
 
+void Task::endStepTrace()
+{
+    if (m_tracedStep == Undefied)
+        return;
+
+    Tracing::end(TaskStepParser::enumToStringStep(m_tracedStep).c_str(), m_appId);
+    m_tracedStep = Undefied;
+}
@@ -22,6 +22,7 @@
 #include <pbnjson.hpp>
 
 #include "InstallHistory.h"
+#include "settings/StepSettings.h"
 #include "step/Step.h"
 
 class Step;
@@ -76,9 +77,26 @@ public:
     //! to pbnjson::JValue
     pbnjson::JValue toJValue() const;
 
+    /*! get toJValue() serialized to string, empty if task has no status
+     * It's cached and rebuilt only after status is changed
+     */
+    const std::string& getStatusString() const;
+
     // get task name
     std::string getName() const;
 
+    //! get monotonic time in us when task is created
+    int64_t getCreatedTime() const;
+
+    //! get monotonic time in us when task is run, 0 if it's not run yet
+    int64_t getRunTime() const;
+
+    //! steps and monotonic time in us when task is moved to each of them
+    typedef std::vector<std::pair<TaskStep, int64_t> > StepTimes;
+
+    //! get steps task has passed with their start time
+    const StepTimes& getStepTimes() const;
+
     //! get sender
     std::string getSender() const;
 
@@ -94,12 +112,35 @@ public:
     //! get whether error has occured
     bool isError() const;
 
-    //! prepare status map
-    bool prepareStep(std::map<TaskStep, TaskStep> mapStep);
+    //! prepare step graph and Step creators, registry should be alive while task is alive
+    bool prepareStep(const StepSettings::StepRegistry *registry);
+
+    //! get whether task installs PWA
+    bool isPWA() const;
 
     //! proceed status
     bool proceed();
 
+    //! check current step is completed one which has next step in step graph
+    bool isCheckpoint() const;
+
+    /*! get current step with values which later steps need
+     * It's journaled, so task can be resumed from it after restart
+     */
+    pbnjson::JValue getCheckpoint() const;
+
+    //! restore values of getCheckpoint() before run, task proceeds to next step of it
+    void resume(pbnjson::JValue checkpoint);
+
+    /*! cancel task
+     * It's finished with InstallCanceled at once if current step can stop its work,
+     * otherwise when current step proceeds task
+     */
+    bool cancel();
+
+    //! check whether cancel is requested
+    bool isCanceled() const;
+
     //! change current status
     void setStep(TaskStep step, bool forceSet = false);
 
@@ -110,6 +151,12 @@ public:
 
     void setUnpackFilesize(uint64_t unpackFileSize);
 
+    //! set install progress in percent, status is notified only when it's changed
+    void setProgress(int progress);
+
+    //! get install progress in percent
+    int getProgress() const;
+
     //! get luna request param;
     pbnjson::JValue getParam() const;
 
@@ -125,6 +172,12 @@ public:
     //! get PackageId
     std::string getPackageId() const;
 
+    //! set version of package in ipk control
+    void setPackageVersion(std::string packageVersion);
+
+    //! get version of package in ipk control
+    std::string getPackageVersion() const;
+
     //! set packFileSize & unpackFileSize
     void setFilesize(uint64_t packFileSize, uint64_t unpackFileSize);
 
@@ -165,6 +218,9 @@ protected:
     //! finish this task
     void finish();
 
+    //! end trace span of current step
+    void endStepTrace();
+
     std::shared_ptr<Step> createStep(const TaskStep step);
 
 private:
@@ -187,11 +243,13 @@ private:
     std::string m_errorText;
 
     TaskStep m_step;
-    std::map<TaskStep, TaskStep> m_mapStep;
+    const StepSettings::StepRegistry *m_registry;
     std::shared_ptr<Step> m_currentStep;
 
     bool m_finished;
     bool m_run;
+    bool m_canceled;
+    bool m_isPWA;
 
     //luna-request param;
     pbnjson::JValue m_param;
@@ -204,8 +262,19 @@ private:
     //TODO : Need to move task specific values
     //packageInfo
     std::string m_packageId;
+    std::string m_packageVersion;
     bool m_hasInstalledSizeWithControlFile;
     uint64_t m_unpackFileSize;
+    int m_progress;
+
+    mutable std::string m_statusCache;
+    mutable bool m_statusDirty;
+
+    //! monotonic time in us
+    int64_t m_createdTime;
+    int64_t m_runTime;
+    StepTimes m_stepTimes;
+    TaskStep m_tracedStep;
     uint64_t m_packFileSize;
 
     //TODO : Need to move
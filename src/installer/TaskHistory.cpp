@@ -0,0 +1,202 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <glib.h>
+#include <map>
+#include <vector>
+
+#include "TaskHistory.h"
+#include "base/Logging.h"
+#include "installer/Task.h"
+
+//! maximum number of records kept, oldest one is dropped first
+#define TASK_HISTORY_SIZE 64
+
+//! nearest rank percentile of sorted values
+static int64_t percentile(const std::vector<int64_t> &sorted, int percent)
+{
+    if (sorted.empty())
+        return 0;
+    size_t rank = (sorted.size() * percent + 99) / 100;
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+static pbnjson::JValue toLatency(std::vector<int64_t> values)
+{
+    std::sort(values.begin(), values.end());
+
+    pbnjson::JValue json = pbnjson::Object();
+    json.put("count", (int64_t) values.size());
+    json.put("p50", percentile(values, 50));
+    json.put("p99", percentile(values, 99));
+    return json;
+}
+
+TaskHistory::TaskHistory()
+{
+}
+
+TaskHistory::~TaskHistory()
+{
+}
+
+void TaskHistory::add(const Task &task)
+{
+    int64_t now = g_get_monotonic_time();
+
+    Record record;
+    record.appId = task.getAppId();
+    record.name = task.getName();
+    record.client = task.getSender();
+    record.step = task.getStep();
+    record.errorCode = task.getErrorCode();
+    record.errorText = task.getErrorText();
+    record.finishedTime = g_get_real_time() / 1000;
+    if (task.getRunTime() != 0) {
+        record.waitTime = (task.getRunTime() - task.getCreatedTime()) / 1000;
+        record.runTime = (now - task.getRunTime()) / 1000;
+    } else {
+        record.waitTime = (now - task.getCreatedTime()) / 1000;
+        record.runTime = 0;
+    }
+
+    // last step is terminal one, task is finished as soon as it's reached
+    const Task::StepTimes &stepTimes = task.getStepTimes();
+    for (size_t i = 0; i + 1 < stepTimes.size(); ++i)
+        record.steps.emplace_back(stepTimes[i].first, (stepTimes[i + 1].second - stepTimes[i].second) / 1000);
+
+    if (record.step == InstallComplete) {
+        LOG_NORMAL(MSGID_APP_INSTALLED, 2,
+                   PMLOGKS(APP_ID, record.appId.c_str()),
+                   PMLOGKS(CALLER, record.client.c_str()),
+                   "");
+    } else if (record.step == RemoveComplete) {
+        LOG_INFO(MSGID_APP_REMOVED, 2,
+                 PMLOGKS(APP_ID, record.appId.c_str()),
+                 PMLOGKS(CALLER, record.client.c_str()),
+                 "");
+    }
+
+    if (m_records.size() >= TASK_HISTORY_SIZE)
+        m_records.pop_front();
+    m_records.push_back(std::move(record));
+}
+
+const TaskHistory::Record* TaskHistory::getLastRecord() const
+{
+    return m_records.empty() ? nullptr : &m_records.back();
+}
+
+const std::deque<TaskHistory::Record>& TaskHistory::getRecords() const
+{
+    return m_records;
+}
+
+pbnjson::JValue TaskHistory::toJValue() const
+{
+    pbnjson::JValue array = pbnjson::Array();
+
+    for (const Record &record : m_records) {
+        pbnjson::JValue json = pbnjson::Object();
+        json.put("id", record.appId);
+        json.put("task", record.name);
+        json.put("client", record.client);
+        json.put("state", TaskStepParser::enumToStringStep(record.step));
+        if (record.errorCode != 0) {
+            json.put("errorCode", record.errorCode);
+            json.put("reason", record.errorText);
+        }
+        json.put("finishedTime", record.finishedTime);
+        json.put("waitTime", record.waitTime);
+        json.put("runTime", record.runTime);
+
+        pbnjson::JValue steps = pbnjson::Array();
+        for (const auto &step : record.steps) {
+            pbnjson::JValue item = pbnjson::Object();
+            item.put("state", TaskStepParser::enumToStringStep(step.first));
+            item.put("elapsed", step.second);
+            steps.append(item);
+        }
+        json.put("steps", steps);
+        array.append(json);
+    }
+
+    return array;
+}
+
+pbnjson::JValue TaskHistory::getSummary() const
+{
+    // install and remove take different steps, so they're summarized separately
+    struct Metrics {
+        Metrics() : failed(0), completed(0), firstFinished(0), lastFinished(0) {}
+
+        std::vector<int64_t> waitTimes;
+        std::vector<int64_t> runTimes;
+        std::map<TaskStep, std::vector<int64_t> > stepTimes;
+        int failed;
+        int completed;
+        int64_t firstFinished;
+        int64_t lastFinished;
+    };
+    std::map<std::string, Metrics> metricsOfName;
+
+    for (const Record &record : m_records) {
+        Metrics &metrics = metricsOfName[record.name];
+
+        // failed task stops early, its timings would pull latencies down
+        if (record.errorCode != 0) {
+            ++metrics.failed;
+            continue;
+        }
+
+        metrics.waitTimes.push_back(record.waitTime);
+        metrics.runTimes.push_back(record.runTime);
+        for (const auto &step : record.steps)
+            metrics.stepTimes[step.first].push_back(step.second);
+
+        if (metrics.completed == 0)
+            metrics.firstFinished = record.finishedTime;
+        metrics.lastFinished = record.finishedTime;
+        ++metrics.completed;
+    }
+
+    pbnjson::JValue summary = pbnjson::Object();
+    for (auto &item : metricsOfName) {
+        Metrics &metrics = item.second;
+
+        pbnjson::JValue json = pbnjson::Object();
+        json.put("completed", metrics.completed);
+        json.put("failed", metrics.failed);
+        json.put("waitTime", toLatency(std::move(metrics.waitTimes)));
+        json.put("runTime", toLatency(std::move(metrics.runTimes)));
+
+        pbnjson::JValue steps = pbnjson::Object();
+        for (auto &step : metrics.stepTimes)
+            steps.put(TaskStepParser::enumToStringStep(step.first), toLatency(std::move(step.second)));
+        json.put("steps", steps);
+
+        // rate between first and last completed task, it needs at least two of them
+        double completedPerMinute = 0;
+        if (metrics.completed > 1 && metrics.lastFinished > metrics.firstFinished)
+            completedPerMinute = (metrics.completed - 1) * 60000.0 / (metrics.lastFinished - metrics.firstFinished);
+        json.put("completedPerMinute", completedPerMinute);
+
+        summary.put(item.first, json);
+    }
+
+    return summary;
+}
@@ -0,0 +1,90 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TASKHISTORY_H
+#define TASKHISTORY_H
+
+#include <deque>
+#include <pbnjson.hpp>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/Singleton.hpp"
+#include "installer/InstallHistory.h"
+
+class Task;
+
+/*! TaskHistory class keeps records of finished tasks in a ring buffer.
+ * Each task is added exactly once when it's finished, and install/remove
+ * events are logged at that time rather than whenever status is serialized.
+ */
+class TaskHistory : public Singleton<TaskHistory> {
+public:
+    //! finished task
+    struct Record {
+        std::string appId;
+        std::string name;
+        std::string client;
+        TaskStep step;
+        int errorCode;
+        std::string errorText;
+        //! wall clock time in ms when task is finished
+        int64_t finishedTime;
+        //! time in ms from creation to run
+        int64_t waitTime;
+        //! time in ms from run to finish
+        int64_t runTime;
+        /*! time in ms spent in each step, from the step to the next one
+         * Child processes and luna-service calls aren't timed on their own,
+         * their time is counted in the step which is current while they run.
+         * Tracing spans tell them apart
+         */
+        std::vector<std::pair<TaskStep, int64_t> > steps;
+    };
+
+    //! Add finished task and log install/remove event
+    void add(const Task &task);
+
+    //! Get records from oldest to newest
+    const std::deque<Record>& getRecords() const;
+
+    //! Get record of last finished task, nullptr if there is none
+    const Record* getLastRecord() const;
+
+    //! to pbnjson::JValue
+    pbnjson::JValue toJValue() const;
+
+    /*! get metrics of records per task name
+     * p50/p99 of wait time, run time and time spent in each step of completed tasks,
+     * number of completed and failed tasks and completed tasks per minute
+     */
+    pbnjson::JValue getSummary() const;
+
+protected:
+friend class Singleton<TaskHistory>;
+    //! Constructor
+    TaskHistory();
+
+    //! Destructor
+    ~TaskHistory();
+
+private:
+    std::deque<Record> m_records;
+};
+
+#endif
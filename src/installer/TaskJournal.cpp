@@ -0,0 +1,315 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sstream>
+#include <string.h>
+#include <unistd.h>
+
+#include "TaskJournal.h"
+#include "base/JUtil.h"
+#include "base/Logging.h"
+#include "base/Utils.h"
+
+//! interval in ms for syncing buffered step records
+#define JOURNAL_SYNC_INTERVAL 100
+
+namespace {
+
+//! write whole data, it's retried on EINTR
+bool writeAll(int fd, const std::string &data)
+{
+    const char *pos = data.data();
+    size_t remain = data.size();
+    while (remain > 0) {
+        ssize_t written = write(fd, pos, remain);
+        if (written == -1) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+
+        pos += written;
+        remain -= written;
+    }
+
+    return true;
+}
+
+//! one journal line of record
+std::string toLine(const char *op, const std::string &appId, const char *key, pbnjson::JValue value)
+{
+    pbnjson::JValue record = pbnjson::Object();
+    record.put("op", op);
+    record.put("id", appId);
+    record.put(key, value);
+    return JUtil::toSimpleString(std::move(record)) + '\n';
+}
+
+}
+
+TaskJournal::TaskJournal()
+    : m_fd(-1),
+      m_scheduled(false)
+{
+}
+
+TaskJournal::~TaskJournal()
+{
+    close();
+}
+
+bool TaskJournal::open(const std::string &path, std::vector<Record> &unfinished)
+{
+    close();
+
+    m_path = path;
+    read(unfinished);
+
+    std::string dir = m_path.substr(0, m_path.rfind('/'));
+    if (!dir.empty())
+        (void) Utils::make_dir(dir);
+
+    // finished and torn records are dropped, unfinished ones stay until recovered tasks journal again
+    if (!rewrite(unfinished))
+        return false;
+
+    m_fd = ::open(m_path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (m_fd == -1) {
+        LOG_ERROR(MSGID_JOURNAL_WRITE_FAIL, 2,
+                  PMLOGKS(PATH, m_path.c_str()),
+                  PMLOGKS(LOGKEY_ERRTEXT, strerror(errno)),
+                  "Failed to open task journal");
+        return false;
+    }
+
+    return true;
+}
+
+void TaskJournal::close()
+{
+    if (m_fd == -1)
+        return;
+
+    flush();
+    ::close(m_fd);
+    m_fd = -1;
+    m_active.clear();
+}
+
+void TaskJournal::begin(const std::string &appId, pbnjson::JValue param)
+{
+    m_active[appId] = Unknown;
+
+    pbnjson::JValue record = pbnjson::Object();
+    record.put("op", "begin");
+    record.put("id", appId);
+    record.put("param", param);
+    append(std::move(record), true);
+}
+
+void TaskJournal::step(const std::string &appId, TaskStep step, bool sync)
+{
+    auto it = m_active.find(appId);
+    if (it == m_active.end() || it->second == step)
+        return;
+    it->second = step;
+
+    pbnjson::JValue record = pbnjson::Object();
+    record.put("op", "step");
+    record.put("id", appId);
+    record.put("step", (int) step);
+    append(std::move(record), sync);
+}
+
+void TaskJournal::checkpoint(const std::string &appId, pbnjson::JValue checkpoint)
+{
+    if (m_active.find(appId) == m_active.end())
+        return;
+
+    pbnjson::JValue record = pbnjson::Object();
+    record.put("op", "checkpoint");
+    record.put("id", appId);
+    record.put("checkpoint", checkpoint);
+    append(std::move(record), false);
+}
+
+void TaskJournal::end(const std::string &appId)
+{
+    if (m_active.erase(appId) == 0)
+        return;
+
+    pbnjson::JValue record = pbnjson::Object();
+    record.put("op", "end");
+    record.put("id", appId);
+    append(std::move(record), true);
+
+    // nothing to recover, start over to keep the file small
+    if (m_active.empty() && m_fd != -1) {
+        if (ftruncate(m_fd, 0) != 0)
+            LOG_WARNING(MSGID_JOURNAL_WRITE_FAIL, 2,
+                        PMLOGKS(PATH, m_path.c_str()),
+                        PMLOGKS(LOGKEY_ERRTEXT, strerror(errno)),
+                        "Failed to compact task journal");
+    }
+}
+
+void TaskJournal::append(pbnjson::JValue record, bool sync)
+{
+    if (m_fd == -1)
+        return;
+
+    m_buffer += JUtil::toSimpleString(std::move(record));
+    m_buffer += '\n';
+
+    if (sync) {
+        flush();
+        return;
+    }
+
+    if (m_scheduled)
+        return;
+
+    m_scheduled = true;
+    Utils::async([this] {
+        m_scheduled = false;
+        flush();
+    }, JOURNAL_SYNC_INTERVAL);
+}
+
+void TaskJournal::flush()
+{
+    if (m_fd == -1 || m_buffer.empty())
+        return;
+
+    if (!writeAll(m_fd, m_buffer))
+        LOG_WARNING(MSGID_JOURNAL_WRITE_FAIL, 2,
+                    PMLOGKS(PATH, m_path.c_str()),
+                    PMLOGKS(LOGKEY_ERRTEXT, strerror(errno)),
+                    "Failed to write task journal");
+    m_buffer.clear();
+
+    if (fdatasync(m_fd) != 0)
+        LOG_WARNING(MSGID_JOURNAL_WRITE_FAIL, 2,
+                    PMLOGKS(PATH, m_path.c_str()),
+                    PMLOGKS(LOGKEY_ERRTEXT, strerror(errno)),
+                    "Failed to sync task journal");
+}
+
+void TaskJournal::read(std::vector<Record> &unfinished) const
+{
+    std::string rawData = Utils::read_file(m_path);
+    if (rawData.empty())
+        return;
+
+    std::map<std::string, Record> records;
+    std::vector<std::string> order;
+
+    std::istringstream stream(rawData);
+    std::string line;
+    while (std::getline(stream, line)) {
+        // last line might be torn by crash
+        pbnjson::JValue record = JUtil::parseTrusted(line.c_str());
+        if (record.isNull() || !record["op"].isString() || !record["id"].isString())
+            continue;
+
+        std::string op = record["op"].asString();
+        std::string appId = record["id"].asString();
+
+        if (op == "begin") {
+            if (records.find(appId) == records.end())
+                order.push_back(appId);
+            records[appId] = Record();
+            records[appId].param = record["param"];
+        } else if (op == "step") {
+            auto it = records.find(appId);
+            if (it == records.end())
+                continue;
+
+            it->second.lastStep = (TaskStep) record["step"].asNumber<int>();
+            if (it->second.lastStep >= IpkInstallRequested && it->second.lastStep <= IpkInstallComplete)
+                it->second.opkgStarted = true;
+            if (it->second.lastStep == IpkInstallComplete)
+                it->second.opkgCompleted = true;
+        } else if (op == "checkpoint") {
+            auto it = records.find(appId);
+            if (it == records.end() || !record["checkpoint"].isObject())
+                continue;
+
+            it->second.checkpoint = record["checkpoint"];
+        } else if (op == "end") {
+            records.erase(appId);
+        }
+    }
+
+    for (const auto &appId : order) {
+        auto it = records.find(appId);
+        if (it != records.end()) {
+            unfinished.push_back(it->second);
+            records.erase(it);
+        }
+    }
+}
+
+bool TaskJournal::rewrite(const std::vector<Record> &unfinished) const
+{
+    std::string data;
+    for (const Record &record : unfinished) {
+        std::string appId = record.param["id"].asString();
+
+        data += toLine("begin", appId, "param", record.param);
+        // opkg flags are derived from steps, so keep the steps setting them
+        if (record.opkgStarted)
+            data += toLine("step", appId, "step", (int) IpkInstallRequested);
+        if (record.opkgCompleted)
+            data += toLine("step", appId, "step", (int) IpkInstallComplete);
+        if (record.lastStep != Unknown)
+            data += toLine("step", appId, "step", (int) record.lastStep);
+        if (!record.checkpoint.isNull())
+            data += toLine("checkpoint", appId, "checkpoint", record.checkpoint);
+    }
+
+    std::string tmpPath = m_path + ".tmp";
+    int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd == -1) {
+        LOG_ERROR(MSGID_JOURNAL_WRITE_FAIL, 2,
+                  PMLOGKS(PATH, tmpPath.c_str()),
+                  PMLOGKS(LOGKEY_ERRTEXT, strerror(errno)),
+                  "Failed to open task journal");
+        return false;
+    }
+
+    // old journal is replaced only when new one is on storage
+    bool result = writeAll(fd, data) && (fsync(fd) == 0);
+    int error = errno;
+    ::close(fd);
+
+    if (result && ::rename(tmpPath.c_str(), m_path.c_str()) != 0) {
+        result = false;
+        error = errno;
+    }
+
+    if (!result) {
+        LOG_ERROR(MSGID_JOURNAL_WRITE_FAIL, 2,
+                  PMLOGKS(PATH, m_path.c_str()),
+                  PMLOGKS(LOGKEY_ERRTEXT, strerror(error)),
+                  "Failed to rewrite task journal");
+        (void) unlink(tmpPath.c_str());
+    }
+
+    return result;
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TASKJOURNAL_H
+#define TASKJOURNAL_H
+
+#include <map>
+#include <pbnjson.hpp>
+#include <string>
+#include <vector>
+
+#include "base/Singleton.hpp"
+#include "installer/InstallHistory.h"
+
+/*! TaskJournal class records life cycle of tasks to an append-only file.
+ * Each line is one record, "begin" with task param, "step" for each step transition,
+ * "checkpoint" for each completed step with values to resume from it
+ * and "end" when task is finished. Step records are buffered and synced together
+ * after JOURNAL_SYNC_INTERVAL, begin and end records are synced at once.
+ * Tasks which have begin but no end at next start are the ones interrupted by crash.
+ */
+class TaskJournal : public Singleton<TaskJournal> {
+public:
+    //! task which was not finished at last run
+    struct Record {
+        Record() : lastStep(Unknown), opkgStarted(false), opkgCompleted(false) {}
+
+        pbnjson::JValue param;
+        TaskStep lastStep;
+        //! last Task::getCheckpoint(), null if task has not completed any step
+        pbnjson::JValue checkpoint;
+        //! opkg might have changed installed files
+        bool opkgStarted;
+        //! package is installed by opkg
+        bool opkgCompleted;
+    };
+
+    /*! Open journal file.
+     * Unfinished tasks of last run are returned. The file is replaced by one
+     * having only their records, written to temporary file and renamed,
+     * so they're not lost by crash before they're journaled again.
+     */
+    bool open(const std::string &path, std::vector<Record> &unfinished);
+
+    //! Flush pending records and close journal file
+    void close();
+
+    //! Record task is created with param
+    void begin(const std::string &appId, pbnjson::JValue param);
+
+    //! Record task moved to step, it's synced at once if sync is true
+    void step(const std::string &appId, TaskStep step, bool sync = false);
+
+    //! Record task completed a step, it can be resumed from checkpoint
+    void checkpoint(const std::string &appId, pbnjson::JValue checkpoint);
+
+    //! Record task is finished
+    void end(const std::string &appId);
+
+protected:
+friend class Singleton<TaskJournal>;
+    //! Constructor
+    TaskJournal();
+
+    //! Destructor
+    ~TaskJournal();
+
+    //! add record to buffer, it's written at once if sync is true
+    void append(pbnjson::JValue record, bool sync);
+
+    //! write buffered records and sync them to storage
+    void flush();
+
+    //! read unfinished tasks from journal file
+    void read(std::vector<Record> &unfinished) const;
+
+    //! replace journal file with records of given unfinished tasks
+    bool rewrite(const std::vector<Record> &unfinished) const;
+
+private:
+    std::string m_path;
+    int m_fd;
+
+    std::string m_buffer;
+    bool m_scheduled;
+
+    //! last journaled step of tasks not finished yet
+    std::map<std::string, TaskStep> m_active;
+};
+
+#endif
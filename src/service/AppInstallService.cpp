@@ -20,10 +20,32 @@
 #include "base/LSUtils.h"
 #include "base/Utils.h"
 #include "installer/AppInstaller.h"
+#include "installer/TaskHistory.h"
 #include "settings/Settings.h"
 
 using namespace std::placeholders;
 
+//! check ipkUrl is existing ipk file or PWA
+static bool isValidIpkUrl(const std::string &ipkUrl)
+{
+    if (Utils::isPWA(ipkUrl))
+        return Utils::is_File_exist(Utils::getPWAPath(ipkUrl));
+
+    return (-1 != Utils::file_size(ipkUrl) &&
+            ipkUrl.length() > 4 &&
+            ipkUrl.length() - 4 == ipkUrl.rfind(".ipk"));
+}
+
+//! error code of failed request parsing
+static int toErrorCode(JUtil::Error &error)
+{
+    // missing or broken schema is not caller's fault
+    if (error.code() == JUtil::Error::Schema)
+        return APP_INSTALL_ERR_GENERAL;
+
+    return APP_INSTALL_ERR_BADPARAM;
+}
+
 AppInstallService::AppInstallService()
     : ServiceBase(get_service_name())
 {
@@ -38,7 +60,31 @@ bool AppInstallService::attach(GMainLoop* gml)
     if (!ServiceBase::attach(gml))
         return false;
 
-    AppInstaller::instance().initialize();
+    // load request schemas before any request arrives
+    std::vector<std::string> required = {
+        "appInstallService.install",
+        "appInstallService.remove",
+        "appInstallService.status",
+        "appInstallService.installBatch",
+        "appInstallService.cancel",
+        "appInstallService.getInstallHistory"
+    };
+    if (Settings::instance().isDevMode()) {
+        required.push_back("appInstallService.dev.install");
+        required.push_back("appInstallService.dev.remove");
+    }
+
+    // other methods still work, requests of broken one are rejected with APP_INSTALL_ERR_GENERAL
+    if (!JUtil::instance().preloadSchemas(required))
+        LOG_CRITICAL(MSGID_SCHEMA_LOAD_FAIL, 1,
+                     PMLOGKS(PATH, Settings::instance().getSchemaPath().c_str()),
+                     "Request schemas are not loaded completely");
+
+    // tasks still work without journal, they just can't be recovered after crash
+    if (!AppInstaller::instance().initialize())
+        LOG_ERROR(MSGID_SRVC_INIT_FAIL, 1,
+                  PMLOGKS(REASON, "task journal is not available"),
+                  "Interrupted tasks won't be recovered");
 
     return true;
 }
@@ -50,6 +96,9 @@ void AppInstallService::onAttached()
         LS_CATEGORY_MAPPED_METHOD(install, cb_install)
         LS_CATEGORY_MAPPED_METHOD(remove, cb_remove)
         LS_CATEGORY_MAPPED_METHOD(status, cb_status)
+        LS_CATEGORY_MAPPED_METHOD(installBatch, cb_installBatch)
+        LS_CATEGORY_MAPPED_METHOD(cancel, cb_cancel)
+        LS_CATEGORY_MAPPED_METHOD(getInstallHistory, cb_getInstallHistory)
     LS_CREATE_CATEGORY_END
 
     registerCategory("/", LS_CATEGORY_TABLE_NAME(base), NULL, NULL);
@@ -77,7 +126,7 @@ bool AppInstallService::cb_install(LSMessage &message)
     pbnjson::JValue json = JUtil::parse(request.getPayload(), "appInstallService.install", &error);
 
     if (json.isNull()) {
-        return LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, error.detail());
+        return LSUtils::replyError(&request, toErrorCode(error), error.detail());
     }
 
     std::string id = json["id"].asString();
@@ -158,7 +207,7 @@ bool AppInstallService::cb_appinfoCallback(LSHandle* lshandle, LSMessage* appinf
     LSMessage *lsm((LSMessage*)userData);
     Message request(lsm);
 
-    pbnjson::JValue response = JUtil::parse(LSMessageGetPayload(appinfoMsg), std::string(""));
+    pbnjson::JValue response = JUtil::parseTrusted(LSMessageGetPayload(appinfoMsg));
     if(response.hasKey("errorCode")){
         bool ret = LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, "No such id");
         LSMessageUnref(lsm);
@@ -168,7 +217,7 @@ bool AppInstallService::cb_appinfoCallback(LSHandle* lshandle, LSMessage* appinf
     pbnjson::JValue json = JUtil::parse(request.getPayload(), "appInstallService.remove", &error);
 
     if (json.isNull()) {
-        bool ret = LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, error.detail());
+        bool ret = LSUtils::replyError(&request, toErrorCode(error), error.detail());
         LSMessageUnref(lsm);
         return ret;
     }
@@ -228,7 +277,7 @@ bool AppInstallService::cb_remove(LSMessage &message)
     pbnjson::JValue json = JUtil::parse(request.getPayload(), "appInstallService.remove", &error);
 
     if (json.isNull()) {
-        return LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, error.detail());
+        return LSUtils::replyError(&request, toErrorCode(error), error.detail());
     }
 
     std::string id = json["id"].asString();
@@ -267,7 +316,7 @@ bool AppInstallService::cb_status(LSMessage &message)
     pbnjson::JValue json = JUtil::parse(request.getPayload(), "appInstallService.status", &error);
 
     if (json.isNull()) {
-        return LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, error.detail());
+        return LSUtils::replyError(&request, toErrorCode(error), error.detail());
     }
 
     LSError lserror;
@@ -275,17 +324,150 @@ bool AppInstallService::cb_status(LSMessage &message)
     if (request.isSubscription())
         subscribed = LSSubscriptionAdd(Handle::get(), "status", &message, &lserror);
 
+    // task status is already serialized, so reply is built without json dom
+    std::string reply = "{\"status\":{\"apps\":";
+    reply += AppInstaller::instance().getStatusString();
+    reply += "},\"returnValue\":true,\"subscribed\":";
+    reply += (subscribed ? "true" : "false");
+    reply += "}";
+
+    try {
+        request.respond(reply.c_str());
+    } catch (const LS::Error &lserror) {
+        LOG_ERROR(MSGID_LSCALL_ERR, 1, PMLOGKS("[AppInstallService]-status", lserror.what()), "");
+        return false;
+    }
+
+    return true;
+}
+
+bool AppInstallService::cb_installBatch(LSMessage &message)
+{
+    JUtil::Error error;
+    Message request(&message);
+    pbnjson::JValue json = JUtil::parse(request.getPayload(), "appInstallService.installBatch", &error);
+
+    if (json.isNull()) {
+        return LSUtils::replyError(&request, toErrorCode(error), error.detail());
+    }
+
+    pbnjson::JValue packages = json["packages"];
+    for (int i = 0; i < packages.arraySize(); ++i) {
+        std::string id = packages[i]["id"].asString();
+        std::string ipkUrl = packages[i]["ipkUrl"].asString();
+
+        if (id.empty())
+            return LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, "id is empty");
+        if (ipkUrl.empty())
+            return LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, "ipkUrl is empty");
+        if (!isValidIpkUrl(ipkUrl))
+            return LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, "invalid ipkUrl: " + ipkUrl);
+    }
+
+    int errorCode = 0;
+    std::string errorText;
+
+    std::string batchId = AppInstaller::instance().installBatch(packages,
+                                                                LSUtils::getCallerId(&request),
+                                                                errorCode,
+                                                                errorText);
+    if (batchId.empty()) {
+        LOG_ERROR(MSGID_APP_INSTALL_ERR, 2,
+                  PMLOGKFV(LOGKEY_ERRCODE, "%d", errorCode),
+                  PMLOGKS(LOGKEY_ERRTEXT, errorText.c_str()),
+                  "Batch install failed");
+
+        return LSUtils::replyError(&request, errorCode, std::move(errorText));
+    }
+
+    LSError lserror;
+    bool subscribed = false;
+    if (request.isSubscription())
+        subscribed = LSSubscriptionAdd(Handle::get(),
+                                       (std::string("batch_") + batchId).c_str(),
+                                       &message,
+                                       &lserror);
+
     pbnjson::JValue reply = pbnjson::Object();
-    pbnjson::JValue status = pbnjson::Object();
-    status.put("apps", AppInstaller::instance().toJValue());
-    reply.put("status", status);
     reply.put("returnValue", true);
+    reply.put("batchId", batchId);
     reply.put("subscribed", subscribed);
 
     try {
         request.respond(JUtil::toSimpleString(std::move(reply)).c_str());
     } catch (const LS::Error &lserror) {
-        LOG_ERROR(MSGID_LSCALL_ERR, 1, PMLOGKS("[AppInstallService]-status", lserror.what()), "");
+        LOG_ERROR(MSGID_LSCALL_ERR, 1, PMLOGKS("[AppInstallService]-installBatch", lserror.what()), "");
+        return false;
+    }
+
+    return true;
+}
+
+bool AppInstallService::cb_cancel(LSMessage &message)
+{
+    JUtil::Error error;
+    Message request(&message);
+    pbnjson::JValue json = JUtil::parse(request.getPayload(), "appInstallService.cancel", &error);
+
+    if (json.isNull()) {
+        return LSUtils::replyError(&request, toErrorCode(error), error.detail());
+    }
+
+    std::string id = json["id"].asString();
+
+    if (id.empty())
+        return LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, "id is empty");
+
+    LOG_INFO(MSGID_APP_INSTALL_CANCEL_REQ, 2,
+             PMLOGKS(APP_ID, id.c_str()),
+             PMLOGKS(CALLER, LSUtils::getCallerId(&request).c_str()),
+             "Application install cancel request received");
+
+    int errorCode = 0;
+    std::string errorText;
+
+    if (!AppInstaller::instance().cancel(id, errorCode, errorText)) {
+        LOG_ERROR(MSGID_APP_INSTALL_CANCEL_ERR, 3,
+                  PMLOGKS(APP_ID, id.c_str()),
+                  PMLOGKFV(LOGKEY_ERRCODE, "%d", errorCode),
+                  PMLOGKS(LOGKEY_ERRTEXT, errorText.c_str()),
+                  "Application install cancel failed");
+
+        return LSUtils::replyError(&request, errorCode, std::move(errorText));
+    }
+
+    pbnjson::JValue reply = pbnjson::Object();
+    reply.put("returnValue", true);
+
+    try {
+        request.respond(JUtil::toSimpleString(std::move(reply)).c_str());
+    } catch (const LS::Error &lserror) {
+        LOG_ERROR(MSGID_LSCALL_ERR, 1, PMLOGKS("[AppInstallService]-cancel", lserror.what()), "");
+        return false;
+    }
+
+    return true;
+}
+
+bool AppInstallService::cb_getInstallHistory(LSMessage &message)
+{
+    JUtil::Error error;
+    Message request(&message);
+    pbnjson::JValue json = JUtil::parse(request.getPayload(), "appInstallService.getInstallHistory", &error);
+
+    if (json.isNull()) {
+        return LSUtils::replyError(&request, toErrorCode(error), error.detail());
+    }
+
+    pbnjson::JValue reply = pbnjson::Object();
+    reply.put("history", TaskHistory::instance().toJValue());
+    reply.put("summary", TaskHistory::instance().getSummary());
+    reply.put("returnValue", true);
+
+    try {
+        request.respond(JUtil::toSimpleString(std::move(reply)).c_str());
+    } catch (const LS::Error &lserror) {
+        LOG_ERROR(MSGID_LSCALL_ERR, 1, PMLOGKS("[AppInstallService]-getInstallHistory", lserror.what()), "");
         return false;
     }
 
@@ -299,7 +481,7 @@ bool AppInstallService::cb_dev_install(LSMessage &message)
     pbnjson::JValue json = JUtil::parse(request.getPayload(), "appInstallService.dev.install", &error);
 
     if (json.isNull()) {
-        return LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, error.detail());
+        return LSUtils::replyError(&request, toErrorCode(error), error.detail());
     }
 
     std::string id = json["id"].asString();
@@ -389,7 +571,7 @@ bool AppInstallService::cb_dev_appinfoCallback(LSHandle* lshandle, LSMessage* ap
         return true;
     }
 
-    pbnjson::JValue response = JUtil::parse(LSMessageGetPayload(appinfoMsg), std::string(""),&error_appinfo_parse);
+    pbnjson::JValue response = JUtil::parseTrusted(LSMessageGetPayload(appinfoMsg), &error_appinfo_parse);
     bool retVal = response.hasKey("returnValue")? response["returnValue"].asBool(): true;
 
     if ((error_appinfo_parse.code() != JUtil::Error::ErrorCode::None) ||
@@ -415,7 +597,7 @@ bool AppInstallService::cb_dev_appinfoCallback(LSHandle* lshandle, LSMessage* ap
     pbnjson::JValue json = JUtil::parse(request.getPayload(), "appInstallService.dev.remove", &error);
 
     if (json.isNull()) {
-        bool ret = LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, error.detail());
+        bool ret = LSUtils::replyError(&request, toErrorCode(error), error.detail());
         LSMessageUnref(lsm);
         return ret;
     }
@@ -480,7 +662,7 @@ bool AppInstallService::cb_dev_remove(LSMessage &message)
     pbnjson::JValue json = JUtil::parse(request.getPayload(), "appInstallService.dev.remove", &error);
 
     if (json.isNull()) {
-        return LSUtils::replyError(&request, APP_INSTALL_ERR_BADPARAM, error.detail());
+        return LSUtils::replyError(&request, toErrorCode(error), error.detail());
     }
 
     std::string id = json.hasKey("id")? json["id"].asString(): "";
@@ -46,6 +46,15 @@ protected:
     //! LS callback for com.webos.appInstallService/status
     bool cb_status(LSMessage &message);
 
+    //! LS callback for com.webos.appInstallService/installBatch
+    bool cb_installBatch(LSMessage &message);
+
+    //! LS callback for com.webos.appInstallService/cancel
+    bool cb_cancel(LSMessage &message);
+
+    //! LS callback for com.webos.appInstallService/getInstallHistory
+    bool cb_getInstallHistory(LSMessage &message);
+
     //! LS callback for com.webos.appInstallService/dev/install
     bool cb_dev_install(LSMessage &message);
 
@@ -14,6 +14,8 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <stdlib.h>
 #include <string>
 
 #include "webospaths.h"
@@ -39,8 +41,15 @@ Settings::Settings()
       m_opkgConfPath( WEBOS_INSTALL_WEBOS_SYSCONFDIR "/appinstalld/opkg.conf"),
       m_lunaFilesPath(WEBOS_INSTALL_WEBOS_LOCALSTATEDIR "/ls2"),
       m_developerlunaFilesPath(WEBOS_INSTALL_WEBOS_LOCALSTATEDIR "/ls2-dev"),
+      m_sysbusRootPath(""),
       m_jsservicePath(WEBOS_INSTALL_BINDIR "/run-js-service"),
       m_jailerPath( WEBOS_INSTALL_BINDIR "/jailer"),
+      m_installerUtilityPath(WEBOS_INSTALL_BINDIR "/ApplicationInstallerUtility"),
+      m_cpusharesPath(WEBOS_INSTALL_SBINDIR "/setcpushares-task"),
+      m_smackctlPath(SMACKCTL_EXEC),
+      m_smackRulesGenPath(SMACK_RULES_GEN_EXEC),
+      m_smackRulesDir(SMACK_RULES_DIR),
+      m_smackXattrPrefix(SMACK_XATTR_PREFIX),
       m_roleTemplatePathNDK(WEBOS_INSTALL_DATADIR "/rolegen/templates/NDK"),
       m_roleTemplatePathWebApp(WEBOS_INSTALL_DATADIR "/rolegen/templates/WebApp.json"),
       m_roleTemplatePathJSService(WEBOS_INSTALL_DATADIR "/rolegen/templates/JSService.json"),
@@ -57,15 +66,30 @@ Settings::Settings()
       m_supportUI(true),
       m_supportUpdateService(true),
       m_timeout(3 * 60 * 1000),
-      m_minimumAppSize(100 * 1024)
-{
+      m_minimumAppSize(100 * 1024),
+      m_maxConcurrentTasks(2),
+      m_statusInterval(0),
+      m_opkgBatchInstall(false),
+      m_lunaCallTimeout(0),
+      m_lunaCallRetries(0),
+      m_lunaCallRetryBackoff(1000)
+{
+    // conf and schemas can be taken from other place to run without installed files
+    const char *confPath = getenv("APPINSTALLD_CONF_PATH");
+    if (confPath && *confPath)
+        m_confPath = confPath;
+
+    const char *schemaPath = getenv("APPINSTALLD_SCHEMA_PATH");
+    if (schemaPath && *schemaPath)
+        m_schemaPath = std::string(schemaPath) + "/";
+
     if (0 == access(m_devModePath.c_str(), F_OK))
         m_isDevMode = true;
 
     if (0 == access(m_jailerPath.c_str(), F_OK))
         m_isJailMode = true;
 
-    if (0 == access(SMACK_RULES_GEN_EXEC, F_OK))
+    if (0 == access(m_smackRulesGenPath.c_str(), F_OK))
         m_isSmackMode = true;
 
     if (!parseOpkgConfigure())
@@ -108,6 +132,58 @@ bool Settings::parseOpkgConfigure()
     return true;
 }
 
+bool Settings::loadConfigure()
+{
+    JUtil::Error error;
+    pbnjson::JValue root = JUtil::parseFile(m_confPath, "appinstalld-conf", &error);
+    if (root.isNull()) {
+        LOG_WARNING(MSGID_SETTINGS_PARSE_FAIL, 1, PMLOGKS("FILE", m_confPath.c_str()), "");
+        return false;
+    }
+
+    if (root["installerDataPath"].isString())
+        m_installerDataPath = root["installerDataPath"].asString();
+    if (root["userinstallPath"].isString())
+        m_userinstallPath = root["userinstallPath"].asString();
+    if (root["jsservicePath"].isString())
+        m_jsservicePath = root["jsservicePath"].asString();
+    if (root["installerUtilityPath"].isString())
+        m_installerUtilityPath = root["installerUtilityPath"].asString();
+    if (root["cpusharesPath"].isString())
+        m_cpusharesPath = root["cpusharesPath"].asString();
+    if (root["smackctlPath"].isString())
+        m_smackctlPath = root["smackctlPath"].asString();
+    if (root["smackRulesGenPath"].isString()) {
+        m_smackRulesGenPath = root["smackRulesGenPath"].asString();
+        m_isSmackMode = (0 == access(m_smackRulesGenPath.c_str(), F_OK));
+    }
+    if (root["smackRulesDir"].isString())
+        m_smackRulesDir = root["smackRulesDir"].asString();
+    if (root["smackXattrPrefix"].isString())
+        m_smackXattrPrefix = root["smackXattrPrefix"].asString();
+    if (root["sysbusRootPath"].isString())
+        m_sysbusRootPath = root["sysbusRootPath"].asString();
+    if (root["jailerPath"].isString()) {
+        m_jailerPath = root["jailerPath"].asString();
+        m_isJailMode = (0 == access(m_jailerPath.c_str(), F_OK));
+    }
+
+    if (root["maxConcurrentTasks"].isNumber())
+        m_maxConcurrentTasks = std::max(1, root["maxConcurrentTasks"].asNumber<int>());
+    if (root["statusInterval"].isNumber())
+        m_statusInterval = std::max(0, root["statusInterval"].asNumber<int>());
+    if (root["opkgBatchInstall"].isBoolean())
+        m_opkgBatchInstall = root["opkgBatchInstall"].asBool();
+    if (root["lunaCallTimeout"].isNumber())
+        m_lunaCallTimeout = std::max(0, root["lunaCallTimeout"].asNumber<int>());
+    if (root["lunaCallRetries"].isNumber())
+        m_lunaCallRetries = std::max(0, root["lunaCallRetries"].asNumber<int>());
+    if (root["lunaCallRetryBackoff"].isNumber())
+        m_lunaCallRetryBackoff = std::max(0, root["lunaCallRetryBackoff"].asNumber<int>());
+
+    return true;
+}
+
 std::string Settings::getInstallPath(bool verified) const
 {
     return (verified) ? m_userinstallPath : m_developerinstallPath;
@@ -135,7 +211,7 @@ std::string Settings::getInstallServicePath(bool verified) const
 
 std::string Settings::getLunaFilesPath(bool verified) const
 {
-    return (verified) ? m_lunaFilesPath : m_developerlunaFilesPath;
+    return m_sysbusRootPath + ((verified) ? m_lunaFilesPath : m_developerlunaFilesPath);
 }
 
 std::string Settings::getLunaRoleFilesPath(bool verified, bool pub) const
@@ -168,43 +244,46 @@ std::string Settings::getApplicationInstallPath() const
     return m_applicationinstallPath;
 }
 
-const char *Settings::getLunaUnifiedRolesDir(bool verified)
+const std::string& Settings::getSysbusRootPath() const
+{
+    return m_sysbusRootPath;
+}
+
+std::string Settings::getLunaUnifiedRolesDir(bool verified) const
 {
-    return verified ? WEBOS_INSTALL_SYSBUS_DYNROLESDIR : WEBOS_INSTALL_SYSBUS_DEVROLESDIR;
+    return m_sysbusRootPath + (verified ? WEBOS_INSTALL_SYSBUS_DYNROLESDIR : WEBOS_INSTALL_SYSBUS_DEVROLESDIR);
 }
 
-const char *Settings::getLunaUnifiedPermissionsDir(bool verified, bool full)
+std::string Settings::getLunaUnifiedPermissionsDir(bool verified, bool full) const
 {
     if (full)
-        return verified ? WEBOS_INSTALL_SYSBUS_DYNPERMISSIONSDIR : WEBOS_INSTALL_SYSBUS_DEVPERMISSIONSDIR;
+        return m_sysbusRootPath + (verified ? WEBOS_INSTALL_SYSBUS_DYNPERMISSIONSDIR : WEBOS_INSTALL_SYSBUS_DEVPERMISSIONSDIR);
     else
-        return verified ? "/var/luna-service2/client-permissions.d" : "/var/luna-service2-dev/client-permissions.d";
+        return m_sysbusRootPath + (verified ? "/var/luna-service2/client-permissions.d" : "/var/luna-service2-dev/client-permissions.d");
 }
 
-const char *Settings::getLunaUnifiedServicesDir(bool verified)
+std::string Settings::getLunaUnifiedServicesDir(bool verified) const
 {
-    return verified ? WEBOS_INSTALL_SYSBUS_DYNSERVICESDIR : WEBOS_INSTALL_SYSBUS_DEVSERVICESDIR;
+    return m_sysbusRootPath + (verified ? WEBOS_INSTALL_SYSBUS_DYNSERVICESDIR : WEBOS_INSTALL_SYSBUS_DEVSERVICESDIR);
 }
 
-const char *Settings::getLunaUnifiedAPIPermissionsDir(bool verified)
+std::string Settings::getLunaUnifiedAPIPermissionsDir(bool verified) const
 {
-    return verified ? WEBOS_INSTALL_SYSBUS_DYNAPIPERMISSIONSDIR : WEBOS_INSTALL_SYSBUS_DEVAPIPERMISSIONSDIR;
+    return m_sysbusRootPath + (verified ? WEBOS_INSTALL_SYSBUS_DYNAPIPERMISSIONSDIR : WEBOS_INSTALL_SYSBUS_DEVAPIPERMISSIONSDIR);
 }
 
-const char *Settings::getLunaUnifiedGroupsDir(bool verified)
+std::string Settings::getLunaUnifiedGroupsDir(bool verified) const
 {
-    return verified ? "/var/luna-service2/groups.d" : "/var/luna-service2-dev/groups.d";
+    return m_sysbusRootPath + (verified ? "/var/luna-service2/groups.d" : "/var/luna-service2-dev/groups.d");
 }
 
-
-
-const char *Settings::getLunaUnifiedManifestsDir(bool verified, bool full)
+std::string Settings::getLunaUnifiedManifestsDir(bool verified, bool full) const
 {
     //TODO : Replace path definition from webospaths.h
     if (full)
-        return verified ? WEBOS_INSTALL_SYSBUS_DYNDATADIR "/manifests.d" : WEBOS_INSTALL_SYSBUS_DEVDATADIR "/manifests.d";
+        return m_sysbusRootPath + (verified ? WEBOS_INSTALL_SYSBUS_DYNDATADIR "/manifests.d" : WEBOS_INSTALL_SYSBUS_DEVDATADIR "/manifests.d");
     else
-        return verified ? "/var/luna-service2/manifests.d" : "/var/luna-service2-dev/manifests.d";
+        return m_sysbusRootPath + (verified ? "/var/luna-service2/manifests.d" : "/var/luna-service2-dev/manifests.d");
 }
 
 std::string Settings::getLunaUnifiedJsonFileName(const std::string &appId, const std::string &suffix)
@@ -273,6 +352,11 @@ const std::string& Settings::getOpkgInfoPath() const
     return m_opkgInfoPath;
 }
 
+const std::string& Settings::getOpkgStatusFilePath() const
+{
+    return m_opkgStatusFilePath;
+}
+
 const std::string& Settings::getOpkgLockFilePath() const
 {
     return m_opkgLockFilePath;
@@ -288,6 +372,36 @@ const std::string& Settings::getJailerPath() const
     return m_jailerPath;
 }
 
+const std::string& Settings::getInstallerUtilityPath() const
+{
+    return m_installerUtilityPath;
+}
+
+const std::string& Settings::getCpusharesPath() const
+{
+    return m_cpusharesPath;
+}
+
+const std::string& Settings::getSmackctlPath() const
+{
+    return m_smackctlPath;
+}
+
+const std::string& Settings::getSmackRulesGenPath() const
+{
+    return m_smackRulesGenPath;
+}
+
+const std::string& Settings::getSmackRulesDir() const
+{
+    return m_smackRulesDir;
+}
+
+const std::string& Settings::getSmackXattrPrefix() const
+{
+    return m_smackXattrPrefix;
+}
+
 const std::string& Settings::getRoleTemplatePathNDK() const
 {
     return m_roleTemplatePathNDK;
@@ -343,3 +457,32 @@ const std::string& Settings::getLocalePath() const
     return m_localePath;
 }
 
+int Settings::getMaxConcurrentTasks() const
+{
+    return m_maxConcurrentTasks;
+}
+
+int Settings::getStatusInterval() const
+{
+    return m_statusInterval;
+}
+
+bool Settings::isOpkgBatchInstall() const
+{
+    return m_opkgBatchInstall;
+}
+
+int Settings::getLunaCallTimeout() const
+{
+    return m_lunaCallTimeout;
+}
+
+int Settings::getLunaCallRetries() const
+{
+    return m_lunaCallRetries;
+}
+
+int Settings::getLunaCallRetryBackoff() const
+{
+    return m_lunaCallRetryBackoff;
+}
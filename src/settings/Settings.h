@@ -29,6 +29,9 @@ public:
     /*! parse opkg conf path from opkg.conf file */
     bool parseOpkgConfigure();
 
+    /*! parse optional settings from appinstalld-conf file */
+    bool loadConfigure();
+
     /*! get install base path
      * if it's verified returns m_userinstallPath, or returns m_developerinstallPath
      */
@@ -78,38 +81,43 @@ public:
     std::string getApplicationInstallPath() const;
     std::string getSignageContentsPath() const;
 
+    /*! get root directory prepended to luna-service2 files
+     * It's empty on target, so files are written where ls-hubd reads them
+     */
+    const std::string& getSysbusRootPath() const;
+
     /*! get luna role file path (public/private-agnostic)
      * Versions of luna-service2 approximately newer than 3.11 don't feature
      * separate public and private hubs. New format of role files is also used.
      */
-    const char *getLunaUnifiedRolesDir(bool verified);
+    std::string getLunaUnifiedRolesDir(bool verified) const;
 
     /*! get luna role client permissions path
      * Versions of luna-service2 approximately newer than 3.11 don't feature
      * separate public and private hubs. Permission file is used to request
      * access to specific access control groups like _public_ or _private_.
      */
-    const char *getLunaUnifiedPermissionsDir(bool verified, bool full);
+    std::string getLunaUnifiedPermissionsDir(bool verified, bool full) const;
 
     /*! get luna unified services directory path
      * Versions of luna-service2 approximately newer than 3.11 don't feature
      * separate public and private hubs. Service file is used to specify
      * command line for launching dynamic service.
      */
-    const char *getLunaUnifiedServicesDir(bool verified);
+    std::string getLunaUnifiedServicesDir(bool verified) const;
 
     /*! get luna unified API permissions directory path
      * Versions of luna-service2 approximately newer than 3.11 don't feature
      * separate public and private hubs. API permissions specify security groups which
      * service provides.
      */
-    const char *getLunaUnifiedAPIPermissionsDir(bool verified);
+    std::string getLunaUnifiedAPIPermissionsDir(bool verified) const;
 
-    const char *getLunaUnifiedGroupsDir(bool verified);
+    std::string getLunaUnifiedGroupsDir(bool verified) const;
 
     /*! get luna unified manifest directory path
      */
-    const char *getLunaUnifiedManifestsDir(bool verified, bool full);
+    std::string getLunaUnifiedManifestsDir(bool verified, bool full) const;
 
     /*! form file name appId.suffix.json
      */
@@ -140,9 +148,17 @@ public:
     const std::string& getServiceinstallPath() const;
     const std::string& getOpkgConfPath() const;
     const std::string& getOpkgInfoPath() const;
+    const std::string& getOpkgStatusFilePath() const;
     const std::string& getOpkgLockFilePath() const;
     const std::string& getJsservicePath() const;
     const std::string& getJailerPath() const;
+    const std::string& getInstallerUtilityPath() const;
+    //! empty if ApplicationInstallerUtility is run without cpu shares wrapper
+    const std::string& getCpusharesPath() const;
+    const std::string& getSmackctlPath() const;
+    const std::string& getSmackRulesGenPath() const;
+    const std::string& getSmackRulesDir() const;
+    const std::string& getSmackXattrPrefix() const;
     const std::string& getRoleTemplatePathNDK() const;
     const std::string& getRoleTemplatePathWebApp() const;
     const std::string& getRoleTemplatePathJSService() const;
@@ -155,6 +171,28 @@ public:
     bool isSmackMode();
     const std::string& getLocalePath() const;
 
+    /*! get maximum number of tasks running at once
+     * opkg phases are still serialized by AppInstaller
+     */
+    int getMaxConcurrentTasks() const;
+
+    /*! get interval in ms for coalescing status subscription replies
+     * 0 means status changes are published once per main loop iteration
+     */
+    int getStatusInterval() const;
+
+    //! check whether ipks of several tasks are installed by one opkg run
+    bool isOpkgBatchInstall() const;
+
+    //! get timeout in ms of luna-service call made by call chain, 0 means no timeout
+    int getLunaCallTimeout() const;
+
+    //! get number of retries of idempotent luna-service query after timeout or hub error
+    int getLunaCallRetries() const;
+
+    //! get backoff in ms before first retry, it's doubled on each retry
+    int getLunaCallRetryBackoff() const;
+
 protected:
 friend class Singleton<Settings> ;
     Settings();
@@ -176,8 +214,15 @@ private:
     std::string m_opkgConfPath;             //default : @WEBOS_INSTALL_WEBOS_SYSCONFDIR@/opkg.conf
     std::string m_lunaFilesPath;            //default : @WEBOS_INSTALL_WEBOS_LOCALSTATEDIR@/ls2
     std::string m_developerlunaFilesPath;   //default : @WEBOS_INSTALL_WEBOS_LOCALSTATEDIR@/ls2-dev
+    std::string m_sysbusRootPath;           //default : empty
     std::string m_jsservicePath;            //default : @WEBOS_INSTALL_BINDIR@/run-js-service
     std::string m_jailerPath;               //default : @WEBOS_INSTALL_BINDIR@/usr/bin/jailer
+    std::string m_installerUtilityPath;     //default : @WEBOS_INSTALL_BINDIR@/ApplicationInstallerUtility
+    std::string m_cpusharesPath;            //default : @WEBOS_INSTALL_SBINDIR@/setcpushares-task
+    std::string m_smackctlPath;             //default : smackctl
+    std::string m_smackRulesGenPath;        //default : /usr/share/smack/smack_rules_gen
+    std::string m_smackRulesDir;            //default : /etc/smack/accesses.d/
+    std::string m_smackXattrPrefix;         //default : security.
     std::string m_roleTemplatePathNDK;      //default : @WEBOS_INSTALL_DATADIR@/rolegen/templates/NDK
     std::string m_roleTemplatePathWebApp;   //default : @WEBOS_INSTALL_DATADIR@/rolegen/templates/WebApp.json
     std::string m_roleTemplatePathJSService;   //default : @WEBOS_INSTALL_DATADIR@/rolegen/templates/JSService.json
@@ -199,6 +244,12 @@ private:
     bool m_supportUpdateService;            // default : true
     int m_timeout;                          // default : 3 * 60 * 1000
     int m_minimumAppSize;                  // default : 100 * 1024
+    int m_maxConcurrentTasks;               // default : 2
+    int m_statusInterval;                   // default : 0
+    bool m_opkgBatchInstall;                // default : false
+    int m_lunaCallTimeout;                  // default : 0
+    int m_lunaCallRetries;                  // default : 0
+    int m_lunaCallRetryBackoff;             // default : 1000
 
     std::string m_opkgInfoPath;             //default : /apps/var/lib/opkg/info
     std::string m_opkgStatusFilePath;       //default : /apps/var/lib/opkg/status
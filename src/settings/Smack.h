@@ -17,12 +17,14 @@
 #ifndef SETTINGS_SMACK_H
 #define SETTINGS_SMACK_H
 
-#define CHSMACK_EXEC            "chsmack"
 #define SMACKCTL_EXEC           "smackctl"
 #define SMACK_RULES_GEN_EXEC    "/usr/share/smack/smack_rules_gen"
 #define SMACK_RULES_DIR         "/etc/smack/accesses.d/"
 #define SMACK_EXEC_PREFFIX      "webOS::App::"
 #define SMACK_SERVICE_PREFFIX   "webOS::Service::"
 #define SMACK_RULES_OVERLAY     "/var/smack/accesses.d/"
+#define SMACK_APPLY_DELAY       50  // ms, window for coalescing smackctl apply requests
+#define SMACK_XATTR_PREFIX      "security."
+#define SMACK_LABEL_JOBS        4   // max threads for labeling one directory tree
 
 #endif
@@ -15,15 +15,75 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "StepSettings.h"
+#include "step/AppCloseStep.h"
+#include "step/DataRemoveStep.h"
+#include "step/GetIpkInfoStep.h"
+#include "step/InstallSmackStep.h"
+#include "step/IpkInstallStep.h"
+#include "step/IpkParseStep.h"
+#include "step/IpkRemoveStep.h"
+#include "step/RemoveJailStep.h"
+#include "step/RemoveSmackStep.h"
+#include "step/RemoveStartStep.h"
+#include "step/ServiceInstallStep.h"
+#include "step/ServiceUninstallStep.h"
+#include "step/UnpackagedInstallStep.h"
+
+#include "base/Creator.h"
 
 StepSettings::StepSettings()
 {
+    for (StepRegistry &registry : m_registries)
+        registry.steps.fill(Undefied);
+    registerCreators();
 }
 
 StepSettings::~StepSettings()
 {
 }
 
+const StepSettings::StepRegistry& StepSettings::getRegistry(TaskType type) const
+{
+    return m_registries[type];
+}
+
+void StepSettings::registerCreators()
+{
+    StepRegistry &ipkInstall = m_registries[IpkInstallType];
+    ipkInstall.creators[IpkParseNeeded] = CreatorUsingNew<IpkParseStep>();
+    ipkInstall.creators[GetIpkInfoNeeded] = CreatorUsingNew<GetIpkInfoStep>();
+    ipkInstall.creators[AppCloseNeeded] = CreatorUsingNew<AppCloseStep>();
+    ipkInstall.creators[IpkInstallNeeded] = CreatorUsingNew<IpkInstallStep>();
+    ipkInstall.creators[InstallSmackNeeded] = CreatorUsingNew<InstallSmackStep>();
+    ipkInstall.creators[ServiceInstallNeeded] = CreatorUsingNew<ServiceInstallStep>();
+
+    // PWA is installed from unpacked directory instead of ipk
+    StepRegistry &pwaInstall = m_registries[PWAInstallType];
+    pwaInstall.creators = ipkInstall.creators;
+    pwaInstall.creators[IpkInstallNeeded] = CreatorUsingNew<UnpackagedInstallStep>();
+    pwaInstall.creators[UnpackagedInstallNeeded] = CreatorUsingNew<UnpackagedInstallStep>();
+
+    StepRegistry &remove = m_registries[RemoveType];
+    remove.creators[RemoveNeeded] = CreatorUsingNew<RemoveStartStep>();
+    remove.creators[AppCloseNeeded] = CreatorUsingNew<AppCloseStep>();
+    remove.creators[RemoveJailNeeded] = CreatorUsingNew<RemoveJailStep>();
+    remove.creators[ServiceUninstallNeeded] = CreatorUsingNew<ServiceUninstallStep>();
+    remove.creators[IpkRemoveNeeded] = CreatorUsingNew<IpkRemoveStep>();
+    remove.creators[DataRemoveNeeded] = CreatorUsingNew<DataRemoveStep>();
+    remove.creators[RemoveSmackNeeded] = CreatorUsingNew<RemoveSmackStep>();
+}
+
+void StepSettings::addTransition(StepGraph &graph, TaskStep status, TaskStep action)
+{
+    if (status < 0 || status >= TASK_STEP_COUNT) {
+        LOG_WARNING(MSGID_SETTINGS_PARSE_FAIL, 1, PMLOGKFV("STATUS", "%d", status), "unknown step in conf");
+        return;
+    }
+
+    if (graph[status] == Undefied)
+        graph[status] = action;
+}
+
 bool StepSettings::loadStepConfigure()
 {
     std::string conf_path = Settings::instance().getConfPath();
@@ -39,7 +99,6 @@ bool StepSettings::loadStepConfigure()
         return false;
     }
 
-    TaskStepParser parser;
     std::string keepStatus;
 
     if (root["installSteps"].isArray()) {
@@ -65,7 +124,7 @@ bool StepSettings::loadStepConfigure()
             }
 
             LOG_DEBUG("[StepStettings]::installSteps : status : %s, action : %s", status.c_str(), action.c_str());
-            m_mapInstallSteps.insert(std::pair<TaskStep, TaskStep>(parser.stringToEnumStep(status), parser.stringToEnumStep(action)));
+            addTransition(m_registries[IpkInstallType].steps, TaskStepParser::stringToEnumStep(status), TaskStepParser::stringToEnumStep(action));
         }
     }
 
@@ -102,8 +161,11 @@ bool StepSettings::loadStepConfigure()
             }
 
             LOG_DEBUG("[StepStettings]::removeSteps : status : %s, action : %s", status.c_str(), action.c_str());
-            m_mapRemoveSteps.insert(std::pair<TaskStep, TaskStep>(parser.stringToEnumStep(status), parser.stringToEnumStep(action)));
+            addTransition(m_registries[RemoveType].steps, TaskStepParser::stringToEnumStep(status), TaskStepParser::stringToEnumStep(action));
         }
     }
+
+    // PWA starts from GetIpkInfoComplete and follows same transitions
+    m_registries[PWAInstallType].steps = m_registries[IpkInstallType].steps;
     return true;
 }
@@ -17,8 +17,11 @@
 #ifndef STEP_SETTINGS_H
 #define STEP_SETTINGS_H
 
-#include <map>
+#include <array>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "base/JUtil.h"
 #include "base/Logging.h"
@@ -26,20 +29,65 @@
 #include "base/Utils.h"
 #include "installer/InstallHistory.h"
 #include "Settings.h"
+#include "step/Step.h"
 
 class StepSettings: public Singleton<StepSettings> {
 public:
-    std::map<TaskStep, TaskStep> m_mapInstallSteps;
-    std::map<TaskStep, TaskStep> m_mapRemoveSteps;
+    //! next step of each step, Undefied if there is no transition
+    typedef std::array<TaskStep, TASK_STEP_COUNT> StepGraph;
+    typedef std::function<Step * (void)> Creator;
+
+    //! task types which have their own registry
+    typedef enum {
+        IpkInstallType = 0,
+        PWAInstallType,
+        RemoveType,
+        TASK_TYPE_COUNT
+    } TaskType;
+
+    /*! Step graph and Step creators of a task type.
+     * It's built once at startup and only read by tasks afterwards
+     */
+    struct StepRegistry {
+        StepGraph steps;
+        std::array<Creator, TASK_STEP_COUNT> creators;
+
+        //! get next step of step, Undefied if there is no transition
+        TaskStep getNextStep(TaskStep step) const
+        {
+            if (step < 0 || step >= TASK_STEP_COUNT)
+                return Undefied;
+            return steps[step];
+        }
+
+        //! create Step which performs action step, nullptr if no Step is registered
+        std::shared_ptr<Step> createStep(TaskStep step) const
+        {
+            if (step < 0 || step >= TASK_STEP_COUNT || !creators[step])
+                return nullptr;
+            return std::shared_ptr<Step>(creators[step]());
+        }
+    };
 
     /*! parse appisntalld configuration from appinstalld-conf file */
     bool loadStepConfigure();
 
+    //! get registry of task type
+    const StepRegistry& getRegistry(TaskType type) const;
+
 protected:
 friend class Singleton<StepSettings> ;
     StepSettings();
     virtual ~StepSettings();
 
+    //! register Step creators of each task type
+    void registerCreators();
+
+    //! add transition to graph, first one is kept if status is duplicated
+    static void addTransition(StepGraph &graph, TaskStep status, TaskStep action);
+
+private:
+    std::array<StepRegistry, TASK_TYPE_COUNT> m_registries;
 };
 
 #endif
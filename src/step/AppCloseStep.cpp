@@ -54,11 +54,14 @@ bool AppCloseStep::proceed(Task *task)
         this, _1, _2));
 
 #if defined(ENABLE_SESSION)
+    // sessions are independent, close app of each session at once
+    auto itemSessions = std::make_shared<ParallelCallItem>(ParallelCallItem::JOIN_ALL);
     size_t size = SessionList::getInstance().size();
     for (size_t i = 0; i < size; ++i) {
         const std::string& sessionId = SessionList::getInstance().at(i);
-        addCallItems(sessionId.c_str(), packageId, callchain);
+        addCallItems(sessionId.c_str(), packageId, itemSessions->addBranch());
     }
+    callchain.add(itemSessions);
 #else
     addCallItems(nullptr, packageId, callchain);
 #endif
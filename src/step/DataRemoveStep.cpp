@@ -49,6 +49,7 @@ bool DataRemoveStep::proceed(Task *task)
     }
 
 #if defined(ENABLE_SESSION)
+    auto itemSessions = std::make_shared<ParallelCallItem>(ParallelCallItem::JOIN_ALL);
     size_t size = SessionList::getInstance().size();
     for (size_t i = 0; i < size; ++i) {
         const std::string& sessionId = SessionList::getInstance().at(i);
@@ -56,8 +57,9 @@ bool DataRemoveStep::proceed(Task *task)
             "com.webos.appInstallService",
             sessionId.c_str(),
             dbOwners);
-        callchain.add(itemRemoveDb);
+        itemSessions->addBranch().add(itemRemoveDb);
     }
+    callchain.add(itemSessions);
 #else
     auto itemRemoveDb = std::make_shared<CallChainEventHandler::RemoveDb>(
         "com.webos.appInstallService",
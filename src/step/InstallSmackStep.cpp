@@ -19,6 +19,7 @@
 #include <fstream>
 #include "base/Logging.h"
 #include "installer/AppInfo.h"
+#include "installer/CallChainEventHandler.h"
 #include "installer/ServiceInfo.h"
 #include "installer/PackageInfo.h"
 #include "installer/InstallHistory.h"
@@ -26,7 +27,10 @@
 #include "settings/Settings.h"
 #include "settings/Smack.h"
 
+using namespace std::placeholders;
+
 InstallSmackStep::InstallSmackStep()
+    : m_callChain(nullptr)
 {
 }
 
@@ -47,13 +51,6 @@ bool InstallSmackStep::proceed(Task *task) {
     AppInfo appInfo(applicationPath);
     PackageInfo packageInfo(std::move(packagePath));
 
-    GSpawnFlags flags = (GSpawnFlags)(G_SPAWN_SEARCH_PATH);
-    gchar * argv[9] = {0};
-    GError * gerr = NULL;
-    gint exit_status = 0;
-    gboolean resultStatus;
-    int index = 0;
-
     /* Skip SMACK labeling if app is stub or smack off */
     if (appInfo.isStub()) {
         m_parentTask->setStep(InstallSmackComplete);
@@ -61,120 +58,25 @@ bool InstallSmackStep::proceed(Task *task) {
         return true;
     }
 
-    label = SMACK_EXEC_PREFFIX + packageId;
-
-    argv[index++] = (gchar *)CHSMACK_EXEC;
-    argv[index++] = (gchar *)"-r";
-    argv[index++] = (gchar *)"-t";
-    argv[index++] = (gchar *)"-a";
-    argv[index++] = (gchar *)label.c_str();
-    if (appInfo.isNative()) {
-        argv[index++] = (gchar *)"-e";
-        argv[index++] = (gchar *)label.c_str();
-    }
-    argv[index++] = (gchar *)applicationPath.c_str();
-    argv[index++] = NULL;
-
-    LOG_DEBUG("Executing %s %s %s %s %s %s", argv[0], argv[1], argv[2], argv[3], argv[4], argv[5]);
-    resultStatus = g_spawn_sync(NULL,
-                                argv,
-                                NULL,
-                                flags,
-                                NULL,
-                                NULL,
-                                NULL,
-                                NULL,
-                                &exit_status,
-                                &gerr);
-    LOG_DEBUG("chsmack result status is %d, exit status is %d", (int)resultStatus, (int)WEXITSTATUS(exit_status));
+    CallChain& callchain = CallChain::acquire(std::bind(&InstallSmackStep::onSmackInstalled,
+        this, _1, _2));
 
-    if (gerr) {
-        LOG_ERROR(MSGID_INSTALL_SMACK_FAIL, 2,
-                  PMLOGKS(REASON, "Failed to execute chsmack"),
-                  PMLOGKS(LOGKEY_ERRTEXT,gerr->message),
-                  " ");
-        g_error_free(gerr);
-    }
-
-    if (!resultStatus || exit_status) {
-        LOG_DEBUG("Non-zero exit code from chsmack.");
-        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_SMACK , "unable to execute chsmack command");
-        m_parentTask->proceed();
-        return false;
-    }
+    label = SMACK_EXEC_PREFFIX + packageId;
 
-    std::string rulesFilePath = SMACK_RULES_DIR + packageId;
+    callchain.add(std::make_shared<CallChainEventHandler::LabelSmack>(
+        applicationPath, label, true, appInfo.isNative() ? label : std::string("")));
 
-    (void)g_mkdir_with_parents(SMACK_RULES_DIR, 0755);
-    index = 0;
-    argv[index++] = (gchar *)SMACK_RULES_GEN_EXEC;
-    if (appInfo.isWeb()) argv[index++] = (gchar *)"-bw";
-    else if (appInfo.isQml()) argv[index++] = (gchar *)"-bq";
-    else if (appInfo.isNative()) argv[index++] = (gchar *)"-bn";
-    argv[index++] = (gchar *)packageId.c_str();
-    argv[index++] = (gchar *)"-o";
-    argv[index++] = (gchar *)rulesFilePath.c_str();
-    argv[index++] = NULL;
-    LOG_DEBUG("Executing %s %s %s %s %s", argv[0], argv[1], argv[2], argv[3], argv[4]);
-    resultStatus = g_spawn_sync(NULL,
-                                argv,
-                                NULL,
-                                flags,
-                                NULL,
-                                NULL,
-                                NULL,
-                                NULL,
-                                &exit_status,
-                                &gerr);
-    LOG_DEBUG("smack_rules_gen result status is %d, exit status is %d", (int)resultStatus, (int)WEXITSTATUS(exit_status));
+    const std::string &rulesDir = Settings::instance().getSmackRulesDir();
+    (void)g_mkdir_with_parents(rulesDir.c_str(), 0755);
 
-    if (gerr) {
-        LOG_ERROR(MSGID_INSTALL_SMACK_FAIL, 2,
-                  PMLOGKS(REASON, "Failed to execute smack_rule_gen"),
-                  PMLOGKS(LOGKEY_ERRTEXT,gerr->message),
-                  " ");
-        g_error_free(gerr);
-    }
+    std::vector<std::string> rulesGenArgs({ Settings::instance().getSmackRulesGenPath() });
+    if (appInfo.isWeb()) rulesGenArgs.push_back("-bw");
+    else if (appInfo.isQml()) rulesGenArgs.push_back("-bq");
+    else if (appInfo.isNative()) rulesGenArgs.push_back("-bn");
+    rulesGenArgs.insert(rulesGenArgs.end(), { packageId, "-o", rulesDir + packageId });
+    callchain.add(std::make_shared<CallChainEventHandler::RunCommand>(
+        std::move(rulesGenArgs), "unable to execute smack_rules_gen command"));
 
-    if (!resultStatus || exit_status) {
-        LOG_DEBUG("Non-zero exit code from smack rules generator.");
-        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_SMACK , "unable to execute smack_rules_gen command");
-        m_parentTask->proceed();
-        return false;
-    }
-
-    index = 0;
-    argv[index++] = (gchar *)SMACKCTL_EXEC;
-    argv[index++] = (gchar *)"apply";
-    argv[index++] = NULL;
-    LOG_DEBUG("Executing %s %s", argv[0], argv[1]);
-    resultStatus = g_spawn_sync(NULL,
-                                argv,
-                                NULL,
-                                flags,
-                                NULL,
-                                NULL,
-                                NULL,
-                                NULL,
-                                &exit_status,
-                                &gerr);
-    LOG_DEBUG("smackctl result status is %d, exit status is %d", (int)resultStatus, (int)WEXITSTATUS(exit_status));
-
-    if (gerr) {
-        LOG_ERROR(MSGID_INSTALL_SMACK_FAIL, 2,
-                  PMLOGKS(REASON, "Failed to execute smackctl"),
-                  PMLOGKS(LOGKEY_ERRTEXT,gerr->message),
-                  "");
-        g_error_free(gerr);
-    }
-
-    if (!resultStatus || exit_status) {
-        LOG_DEBUG("Non-zero exit code from smackctl.");
-        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_SMACK, "unable to execute smackctl command");
-        m_parentTask->proceed();
-        return false;
-    }
-    
     if (packageInfo.isLoaded())
         packageInfo.getServices(serviceLists);
 
@@ -186,114 +88,50 @@ bool InstallSmackStep::proceed(Task *task) {
         if (serviceInfo.getType() != "native"){
             label = SMACK_SERVICE_PREFFIX + serviceId;
 
-            index = 0;
-            argv[index++] = (gchar *)CHSMACK_EXEC;
-            argv[index++] = (gchar *)"-r";
-            argv[index++] = (gchar *)"-t";
-            argv[index++] = (gchar *)"-a";
-            argv[index++] = (gchar *)label.c_str();
-            argv[index++] = (gchar *)servicePath.c_str();
-            argv[index++] = NULL;
+            callchain.add(std::make_shared<CallChainEventHandler::LabelSmack>(
+                servicePath, label, true));
 
-            LOG_DEBUG("Executing %s %s %s %s %s %s", argv[0], argv[1], argv[2], argv[3], argv[4], argv[5]);
-            resultStatus = g_spawn_sync(NULL,
-                                        argv,
-                                        NULL,
-                                        flags,
-                                        NULL,
-                                        NULL,
-                                        NULL,
-                                        NULL,
-                                        &exit_status,
-                                        &gerr);
-            LOG_DEBUG("chsmack result status is %d, exit status is %d", (int)resultStatus, (int)WEXITSTATUS(exit_status));
-
-            if (gerr) {
-                LOG_ERROR(MSGID_INSTALL_SMACK_FAIL, 2,
-                        PMLOGKS(REASON, "Failed to execute chsmack"),
-                        PMLOGKS(LOGKEY_ERRTEXT,gerr->message),
-                        " ");
-                g_error_free(gerr);
-            }
+            callchain.add(std::make_shared<CallChainEventHandler::RunCommand>(
+                std::vector<std::string>({ Settings::instance().getSmackRulesGenPath(), "-bs", serviceId, "-o", rulesDir + serviceId }),
+                "unable to execute smack_rules_gen command"));
+        }
+    }
 
-            if (!resultStatus || exit_status) {
-                LOG_DEBUG("Non-zero exit code from chsmack.");
-                m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_SMACK , "unable to execute chsmack command");
-                m_parentTask->proceed();
-                return false;
-            }
+    // load rules of app and services at once
+    callchain.add(std::make_shared<CallChainEventHandler::ApplySmackRules>());
 
-            std::string rulesFilePath = SMACK_RULES_DIR + serviceId;
-            (void)g_mkdir_with_parents(SMACK_RULES_DIR, 0755);
-            index = 0;
-            argv[index++] = (gchar *)SMACK_RULES_GEN_EXEC;
-            argv[index++] = (gchar *)"-bs";
-            argv[index++] = (gchar *)serviceId.c_str();
-            argv[index++] = (gchar *)"-o";
-            argv[index++] = (gchar *)rulesFilePath.c_str();
-            argv[index++] = NULL;
-            LOG_DEBUG("Executing %s %s %s %s %s", argv[0], argv[1], argv[2], argv[3], argv[4]);
-            resultStatus = g_spawn_sync(NULL,
-                                        argv,
-                                        NULL,
-                                        flags,
-                                        NULL,
-                                        NULL,
-                                        NULL,
-                                        NULL,
-                                        &exit_status,
-                                        &gerr);
-            LOG_DEBUG("smack_rules_gen result status is %d, exit status is %d", (int)resultStatus, (int)WEXITSTATUS(exit_status));
+    m_parentTask->setStep(InstallSmackRequested);
+    m_callChain = &callchain;
+    callchain.run();
+    return true;
+}
 
-            if (gerr) {
-                LOG_ERROR(MSGID_INSTALL_SMACK_FAIL, 2,
-                        PMLOGKS(REASON, "Failed to execute smack_rule_gen"),
-                        PMLOGKS(LOGKEY_ERRTEXT,gerr->message),
-                        " ");
-                g_error_free(gerr);
-            }
+bool InstallSmackStep::cancel()
+{
+    // labeling can take long for big apps, skip remaining items
+    if (m_callChain)
+        m_callChain->cancel();
 
-            if (!resultStatus || exit_status) {
-                LOG_DEBUG("Non-zero exit code from smack rules generator.");
-                m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_SMACK , "unable to execute smack_rules_gen command");
-                m_parentTask->proceed();
-                return false;
-            }
+    return false;
+}
 
-            index = 0;
-            argv[index++] = (gchar *)SMACKCTL_EXEC;
-            argv[index++] = (gchar *)"apply";
-            argv[index++] = NULL;
-            LOG_DEBUG("Executing %s %s", argv[0], argv[1]);
-            resultStatus = g_spawn_sync(NULL,
-                                        argv,
-                                        NULL,
-                                        flags,
-                                        NULL,
-                                        NULL,
-                                        NULL,
-                                        NULL,
-                                        &exit_status,
-                                        &gerr);
-            LOG_DEBUG("smackctl result status is %d, exit status is %d", (int)resultStatus, (int)WEXITSTATUS(exit_status));
+bool InstallSmackStep::onSmackInstalled(pbnjson::JValue result, void *user_data)
+{
+    LOG_DEBUG("InstallSmackStep::onSmackInstalled() called\n");
+    m_callChain = nullptr;
 
-            if (gerr) {
-                LOG_ERROR(MSGID_INSTALL_SMACK_FAIL, 2,
-                        PMLOGKS(REASON, "Failed to execute smackctl"),
-                        PMLOGKS(LOGKEY_ERRTEXT,gerr->message),
-                        "");
-                g_error_free(gerr);
-            }
+    if (!result["returnValue"].asBool()) {
+        std::string errorText = result["errorText"].asString();
 
-            if (!resultStatus || exit_status) {
-                LOG_DEBUG("Non-zero exit code from smackctl.");
-                m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_SMACK, "unable to execute smackctl command");
-                m_parentTask->proceed();
-                return false;
-            }
-        }
+        LOG_ERROR(MSGID_INSTALL_SMACK_FAIL, 2,
+                  PMLOGKS(APP_ID, m_parentTask->getAppId().c_str()),
+                  PMLOGKS(LOGKEY_ERRTEXT, errorText.c_str()),
+                  "");
+        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_SMACK, std::move(errorText));
+    } else {
+        m_parentTask->setStep(InstallSmackComplete);
     }
-    m_parentTask->setStep(InstallSmackComplete);
+
     m_parentTask->proceed();
     return true;
 }
@@ -17,8 +17,11 @@
 #ifndef INSTALL_SMACK_STEP_H
 #define INSTALL_SMACK_STEP_H
 
+#include <pbnjson.hpp>
+
 #include "Step.h"
 
+class CallChain;
 class Task;
 class InstallSmackStep : public Step {
 public:
@@ -26,6 +29,16 @@ public:
     virtual ~InstallSmackStep();
 
     virtual bool proceed(Task * task);
+
+    virtual bool cancel();
+
+protected:
+    //! It's called when SMACK commands are done
+    bool onSmackInstalled(pbnjson::JValue result, void *user_data);
+
+private:
+    //! running chain, it's valid until onSmackInstalled is called
+    CallChain *m_callChain;
 };
 
 #endif
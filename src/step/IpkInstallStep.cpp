@@ -15,11 +15,56 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "IpkInstallStep.h"
+#include <cstring>
+#include <dirent.h>
 #include <functional>
+#include <sys/stat.h>
+#include "installer/AppInstaller.h"
+#include "installer/IpkBatchInstaller.h"
 #include "installer/Task.h"
+#include "settings/Settings.h"
 
 using namespace std::placeholders;
 
+//! interval in ms to check unpacked bytes while opkg is running
+#define PROGRESS_CHECK_INTERVAL 500
+
+namespace {
+
+//! sum sizes of regular files under path which are written since given time
+uint64_t getUnpackedSize(const std::string &path, const struct timespec &since)
+{
+    DIR *dir = opendir(path.c_str());
+    if (!dir)
+        return 0;
+
+    uint64_t size = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
+
+        std::string entryPath = path + "/" + entry->d_name;
+        struct stat st;
+        if (lstat(entryPath.c_str(), &st) != 0)
+            continue;
+
+        if (S_ISDIR(st.st_mode)) {
+            size += getUnpackedSize(entryPath, since);
+        } else if (S_ISREG(st.st_mode)) {
+            // files of previous version are left until opkg replaces them
+            if (st.st_ctim.tv_sec > since.tv_sec ||
+                (st.st_ctim.tv_sec == since.tv_sec && st.st_ctim.tv_nsec >= since.tv_nsec))
+                size += st.st_size;
+        }
+    }
+
+    closedir(dir);
+    return size;
+}
+
+}
+
 const std::vector<std::string> opkgInstallValidationErrorFunctions({
     "satisfy_dependencies_for:",
     "check_conflicts_for:",
@@ -32,11 +77,15 @@ const std::vector<std::string> opkgInstallValidationErrorFunctions({
 
 
 IpkInstallStep::IpkInstallStep()
+    : m_batchRequested(false),
+      m_progressSourceId(0),
+      m_startTime({0, 0})
 {
 }
 
 IpkInstallStep::~IpkInstallStep()
 {
+    stopProgressCheck();
     LOG_DEBUG("IpkInstallStep::~IpkInstallStep called\n");
 }
 
@@ -52,33 +101,94 @@ bool IpkInstallStep::proceed(Task *task)
         return false;
     }
 
+    if (Settings::instance().isOpkgBatchInstall()) {
+        requestBatchInstall();
+        return true;
+    }
+
+    // opkg can handle only one command at once, wait for our turn
+    AppInstaller::instance().acquireOpkg(task->getAppId(),
+                                         std::bind(&IpkInstallStep::onOpkgAcquired, this));
+    return true;
+}
+
+bool IpkInstallStep::cancel()
+{
+    LOG_DEBUG("IpkInstallStep::cancel() called\n");
+
+    // other packages are installed by the same run, so it can't be killed
+    if (m_batchRequested)
+        return IpkBatchInstaller::instance().cancel(m_parentTask->getAppId());
+
+    // if opkg is not acquired yet, waiting is released when task is finished
+    stopProgressCheck();
+    m_installerUtility.cancel();
+    return true;
+}
+
+void IpkInstallStep::onOpkgAcquired()
+{
+    LOG_DEBUG("IpkInstallStep::onOpkgAcquired() called\n");
+
     pbnjson::JValue param = m_parentTask->getParam();
     bool verify = param["verify"].asBool();
     std::string ipkFile= param["ipkurl"].asString();
     bool allowDowngrade = param["allowDowngrade"].asBool();
 
     AppInstallerUtility::Result result =
-            m_installerUtility.install(std::move(ipkFile), 0, verify, allowDowngrade, task->isAllowReInstall(), task->getInstallBasePath(),
+            m_installerUtility.install(std::move(ipkFile), 0, verify, allowDowngrade, m_parentTask->isAllowReInstall(), m_parentTask->getInstallBasePath(),
                 std::bind(&IpkInstallStep::cbInstallIpkProgress, this, _1),
                 std::bind(&IpkInstallStep::cbInstallIpkComplete, this, _1));
 
     switch(result)
     {
     case AppInstallerUtility::FAIL:
-        task->setError(ErrorInstall, APP_INSTALL_ERR_GENERAL, "unable to call ApplicationInstallerUtility");
-        return false;
+        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_GENERAL, "unable to call ApplicationInstallerUtility");
+        m_parentTask->proceed();
+        return;
     case AppInstallerUtility::LOCKED:
-        //pause(Task::SYSTEM);
-        return true;
+        // opkg is used by someone out of AppInstaller's control
+        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_GENERAL, "opkg is locked");
+        m_parentTask->proceed();
+        return;
     default:
         break;
     }
 
     sync();
 
-    task->setUnpacked(true);
-    task->setStep(IpkInstallRequested);
-    return true;
+    m_parentTask->setUnpacked(true);
+    m_parentTask->setStep(IpkInstallRequested);
+    startProgressCheck();
+}
+
+void IpkInstallStep::requestBatchInstall()
+{
+    pbnjson::JValue param = m_parentTask->getParam();
+
+    IpkBatchInstaller::Request request;
+    request.appId = m_parentTask->getAppId();
+    request.packageId = m_parentTask->getPackageId();
+    // expected version is used to check result of this package when the run fails
+    request.version = m_parentTask->getPackageVersion();
+    request.ipkFile = param["ipkurl"].asString();
+    request.verify = param["verify"].asBool();
+    request.allowDowngrade = param["allowDowngrade"].asBool();
+    request.allowReInstall = m_parentTask->isAllowReInstall();
+    request.installBasePath = m_parentTask->getInstallBasePath();
+    request.cbStarted = std::bind(&IpkInstallStep::onBatchStarted, this);
+    request.cbProgress = std::bind(&IpkInstallStep::cbInstallIpkProgress, this, _1);
+    request.cbComplete = std::bind(&IpkInstallStep::cbInstallIpkComplete, this, _1);
+
+    m_batchRequested = true;
+    IpkBatchInstaller::instance().install(std::move(request));
+}
+
+void IpkInstallStep::onBatchStarted()
+{
+    m_parentTask->setUnpacked(true);
+    m_parentTask->setStep(IpkInstallRequested);
+    startProgressCheck();
 }
 
 void IpkInstallStep::cbInstallIpkProgress(const char *str)
@@ -108,6 +218,13 @@ void IpkInstallStep::cbInstallIpkProgress(const char *str)
         else if ("done" == status)
             m_parentTask->setStep(IpkInstallComplete);
 
+        // files are all unpacked, 100 is set when opkg exits successfully
+        if ("installing" == status || "done" == status) {
+            stopProgressCheck();
+            if (m_parentTask->getProgress() < 99)
+                m_parentTask->setProgress(99);
+        }
+
         if (!function.empty())
         {
             if (std::find(opkgInstallValidationErrorFunctions.begin()
@@ -120,6 +237,9 @@ void IpkInstallStep::cbInstallIpkProgress(const char *str)
 
 void IpkInstallStep::cbInstallIpkComplete(int status)
 {
+    AppInstaller::instance().releaseOpkg(m_parentTask->getAppId());
+    stopProgressCheck();
+
     if (!WIFEXITED(status) || (WEXITSTATUS(status) != 0))
     {
         std::string errorText;
@@ -151,11 +271,54 @@ void IpkInstallStep::cbInstallIpkComplete(int status)
             PMLOGKS(APP_ID, m_parentTask->getAppId().c_str()),
             PMLOGKFV(STATUS, "%" PRId32, status),
                         " ");
+    } else {
+        m_parentTask->setProgress(100);
     }
 
     m_parentTask->proceed();
 }
 
+void IpkInstallStep::startProgressCheck()
+{
+    // Installed-Size is unknown, progress can't be measured
+    if (m_parentTask->getUnpackFilesize() == 0)
+        return;
+
+    // inode times are taken from coarse clock, so start time should be too
+    clock_gettime(CLOCK_REALTIME_COARSE, &m_startTime);
+
+    m_parentTask->setProgress(0);
+    m_progressSourceId = g_timeout_add(PROGRESS_CHECK_INTERVAL, cbCheckProgress, this);
+}
+
+void IpkInstallStep::stopProgressCheck()
+{
+    if (m_progressSourceId != 0) {
+        g_source_remove(m_progressSourceId);
+        m_progressSourceId = 0;
+    }
+}
+
+gboolean IpkInstallStep::cbCheckProgress(gpointer data)
+{
+    IpkInstallStep *step = static_cast<IpkInstallStep*>(data);
+    Task *task = step->m_parentTask;
+
+    // count only this package, other packages might be unpacked by the same batch run
+    std::string packageId = task->getPackageId();
+    uint64_t unpackedSize =
+        getUnpackedSize(task->getInstallBasePath() + Settings::instance().getApplicationInstallPath() + "/" + packageId, step->m_startTime) +
+        getUnpackedSize(task->getInstallBasePath() + Settings::instance().getPackageinstallPath() + "/" + packageId, step->m_startTime);
+    uint64_t progress = unpackedSize * 100 / task->getUnpackFilesize();
+
+    // 100 is set only when opkg has finished, and progress never goes backward
+    progress = std::min<uint64_t>(progress, 99);
+    if ((int) progress > task->getProgress())
+        task->setProgress(progress);
+
+    return G_SOURCE_CONTINUE;
+}
+
 bool IpkInstallStep::checkStorageSize()
 {
     uint64_t availableSize = 0;
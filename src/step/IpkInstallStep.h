@@ -26,6 +26,7 @@
 #include "base/Logging.h"
 #include "installer/AppPackage.h"
 #include <sys/vfs.h>
+#include <time.h>
 #include <inttypes.h>
 
 class Task;
@@ -40,8 +41,19 @@ public:
 
     virtual bool proceed(Task *task);
 
+    virtual bool cancel();
+
 protected:
 
+    //! It's called when opkg is available for this task
+    void onOpkgAcquired();
+
+    //! request install to IpkBatchInstaller instead of running opkg alone
+    void requestBatchInstall();
+
+    //! It's called when opkg run including this task is started
+    void onBatchStarted();
+
     bool checkStorageSize();
 
     void getStorageSize(const std::string &storagePath, uint64_t *availableSize, uint64_t *totalSize);
@@ -50,10 +62,23 @@ protected:
 
     void cbInstallIpkComplete(int status);
 
+    //! start to watch bytes unpacked into directories of this package for progress
+    void startProgressCheck();
+
+    //! stop watching progress
+    void stopProgressCheck();
+
+    //! compute progress from bytes unpacked so far against Installed-Size
+    static gboolean cbCheckProgress(gpointer data);
 
 private:
 
     AppInstallerUtility m_installerUtility;
+
+    bool m_batchRequested;
+    guint m_progressSourceId;
+    //! time when opkg started, files written since then are unpacked by it
+    struct timespec m_startTime;
 };
 
 #endif
@@ -16,6 +16,7 @@
 
 #include "IpkParseStep.h"
 #include <functional>
+#include "base/Utils.h"
 #include "installer/Task.h"
 
 using namespace std::placeholders;
@@ -43,22 +44,17 @@ bool IpkParseStep::proceed(Task *task)
 
     determineInstallPath();
 
-    if (!Utils::make_dir(m_installDataPath, true))
-    {
-        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_GENERAL, "unable to create install temp directory");
-        m_parentTask->proceed();
-        return false;
-    }
-
+    // only control member is read in memory, so parse time doesn't depend on ipk size
     AppPackage::Control control;
-    if (!m_appPackage.extract(m_ipkFile, AppPackage::CONTROL, m_installDataPath,
-        std::bind(&IpkParseStep::onPackageExtracted, this, _1)))
+    if (!m_appPackage.readControl(m_ipkFile, control))
     {
-        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_GENERAL, "failed to extract ipk file");
-        m_parentTask->proceed();
+        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_INSTALL, "Failed to parse control");
+        // task replaces this step when it proceeds, so step isn't touched after it
+        Utils::async([task] { task->proceed(); });
         return false;
     }
 
+    onControlParsed(control);
     return true;
 }
 
@@ -79,31 +75,13 @@ void IpkParseStep::determineInstallPath()
 
     m_parentTask->setInstallBasePath(installBasePath);
 
-    m_installDataPath = installBasePath + "/tmp/" + m_appId;
-
     LOG_DEBUG("[InstallTask][determineInstallPath] deviceId:%s, installBasePath:%s",
         deviceId.c_str(), installBasePath.c_str());
 }
 
-void IpkParseStep::onPackageExtracted(bool result)
+void IpkParseStep::onControlParsed(const AppPackage::Control &control)
 {
-    LOG_DEBUG("[IpkParseStep]::onPackageExtracted. result: %d\n", result);
-
-    if (!result)
-    {
-        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_INSTALL, "Failed to extract package");
-        m_parentTask->proceed();
-        return;
-    }
-
-    AppPackage appPackage;
-    AppPackage::Control control;
-    if (!appPackage.parseControl(m_installDataPath + "/control", control))
-    {
-        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_INSTALL, "Failed to parse control");
-        m_parentTask->proceed();
-        return;
-    }
+    LOG_DEBUG("[IpkParseStep]::onControlParsed called\n");
 
     LOG_INFO(MSGID_PACKAGE_INFO, 3,
         PMLOGKS(APP_ID, m_appId.c_str()),
@@ -114,16 +92,18 @@ void IpkParseStep::onPackageExtracted(bool result)
     if (m_verify && m_appId != control.getPackage())
     {
         m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_INSTALL, "appId is wrong");
-        m_parentTask->proceed();
+        Task *task = m_parentTask;
+        Utils::async([task] { task->proceed(); });
         return;
     }
 
     m_parentTask->setPackageId(control.getPackage());
+    m_parentTask->setPackageVersion(control.getVersion());
 
     std::string installedControlFilePath = m_parentTask->getInstallBasePath() + Settings::instance().getOpkgInfoPath() + "/" + control.getPackage() + ".control";
 
     AppPackage::Control installedControl;
-    if (appPackage.parseControl(std::move(installedControlFilePath), installedControl))
+    if (m_appPackage.parseControl(std::move(installedControlFilePath), installedControl))
     {
         if (control.getVersion() == installedControl.getVersion())
             m_parentTask->setAllowReInstall(true);
@@ -140,10 +120,10 @@ void IpkParseStep::onPackageExtracted(bool result)
         //m_parentTask->setFilesize(m_packFileSize, unpackFileSize);
         m_parentTask->setUnpackFilesize(unpackFileSize);
 
-
-    Utils::remove_dir(m_installDataPath);
     m_parentTask->setStep(IpkParseComplete);
-    m_parentTask->proceed();
+
+    Task *task = m_parentTask;
+    Utils::async([task] { task->proceed(); });
 }
 
 
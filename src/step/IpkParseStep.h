@@ -42,13 +42,12 @@ protected:
     //! callback function
     void init(Task &task);
 
-    void onPackageExtracted(bool result);
+    void onControlParsed(const AppPackage::Control &control);
 
     void determineInstallPath();
 
 private:
     AppPackage m_appPackage;
-    std::string m_installDataPath;
     std::string m_ipkFile;
 
     bool m_verify;
@@ -15,6 +15,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "IpkRemoveStep.h"
+#include "installer/AppInstaller.h"
 #include "installer/Task.h"
 
 using namespace std::placeholders;
@@ -38,16 +39,6 @@ bool IpkRemoveStep::proceed(Task *task)
     bool verify = param["verify"].asBool();
     std::vector<std::string>& appServices = m_parentTask->getServices();
 
-    CallChain& callchain = CallChain::acquire(std::bind(&IpkRemoveStep::onIpkRemoved,
-        this, _1, _2));
-
-    auto itemInternal = std::make_shared<CallChainEventHandler::RemoveIpk>(
-        m_parentTask->getAppId(),
-        verify,
-        std::string("")
-    );
-    callchain.add(itemInternal);
-
     // read services
     {
         std::string packagePath = Settings::instance().getInstallPath(verify) +
@@ -71,14 +62,37 @@ bool IpkRemoveStep::proceed(Task *task)
     }
 
     m_parentTask->setStep(IpkRemoveRequested);
-    callchain.run();
+
+    // opkg can handle only one command at once, wait for our turn
+    AppInstaller::instance().acquireOpkg(m_parentTask->getAppId(),
+                                         std::bind(&IpkRemoveStep::onOpkgAcquired, this));
     return true;
 }
 
+void IpkRemoveStep::onOpkgAcquired()
+{
+    LOG_DEBUG("IpkRemoveStep::onOpkgAcquired() called\n");
+
+    bool verify = m_parentTask->getParam()["verify"].asBool();
+
+    CallChain& callchain = CallChain::acquire(std::bind(&IpkRemoveStep::onIpkRemoved,
+        this, _1, _2));
+
+    auto itemInternal = std::make_shared<CallChainEventHandler::RemoveIpk>(
+        m_parentTask->getAppId(),
+        verify,
+        std::string("")
+    );
+    callchain.add(itemInternal);
+    callchain.run();
+}
+
 bool IpkRemoveStep::onIpkRemoved(pbnjson::JValue result, void *user_data)
 {
     LOG_DEBUG("IpkRemoveStep::onIpkRemoved() called\n");
 
+    AppInstaller::instance().releaseOpkg(m_parentTask->getAppId());
+
     bool returnValue = result["returnValue"].asBool();
 
     int removed = (result.hasKey("removed")) ? result["removed"].asNumber<int>() : 0;
@@ -39,6 +39,9 @@ public:
     virtual bool proceed(Task *task);
 
 protected:
+    //! It's called when opkg is available for this task
+    void onOpkgAcquired();
+
     bool onIpkRemoved(pbnjson::JValue result, void *user_data);
 };
 
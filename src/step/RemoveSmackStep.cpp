@@ -20,10 +20,13 @@
 #include "installer/AppInfo.h"
 #include "base/Logging.h"
 #include "settings/Settings.h"
+#include "installer/CallChainEventHandler.h"
 #include "installer/InstallHistory.h"
 #include "installer/Task.h"
 #include "settings/Smack.h"
 
+using namespace std::placeholders;
+
 RemoveSmackStep::RemoveSmackStep()
 {
 }
@@ -38,21 +41,14 @@ bool RemoveSmackStep::proceed(Task *task)
     LOG_DEBUG("RemoveSmackStep::proceed() called\n");
 
     std::string prefix;
-    std::string mountExec = "mount";
     std::vector<std::string> rulePaths;
-    GSpawnFlags flags = (GSpawnFlags)(G_SPAWN_SEARCH_PATH);
-    gchar * argv[9] = {0};
-    GError * gerr = NULL;
-    gint exit_status = 0;
-    gboolean resultStatus;
-    int index = 0;
 
     m_parentTask = task;
 
     if (g_file_test((SMACK_RULES_OVERLAY + m_parentTask->getAppId()).c_str(), G_FILE_TEST_EXISTS)) {
         prefix = SMACK_RULES_OVERLAY;
     } else {
-        prefix = SMACK_RULES_DIR;
+        prefix = Settings::instance().getSmackRulesDir();
     }
 
     rulePaths.push_back(prefix + m_parentTask->getAppId());
@@ -102,76 +98,39 @@ bool RemoveSmackStep::proceed(Task *task)
             }
         }
     }
-    if (prefix == SMACK_RULES_OVERLAY) {
-        index = 0;
-        argv[index++] = (gchar *)mountExec.c_str();
-        argv[index++] = (gchar *)"-o";
-        argv[index++] = (gchar *)"remount";
-        argv[index++] = (gchar *)SMACK_RULES_DIR;
-        argv[index++] = NULL;
-        LOG_DEBUG("Executing %s %s %s %s", argv[0], argv[1], argv[2], argv[3]);
-        resultStatus = g_spawn_sync(NULL,
-                                    argv,
-                                    NULL,
-                                    flags,
-                                    NULL,
-                                    NULL,
-                                    NULL,
-                                    NULL,
-                                    &exit_status,
-                                    &gerr);
-        LOG_DEBUG("%s result status is %d, exit status is %d", mountExec.c_str(), (int)resultStatus, (int)WEXITSTATUS(exit_status));
-
-        if (gerr) {
-            LOG_ERROR(MSGID_INSTALL_SMACK_FAIL, 2,
-                PMLOGKS(REASON, "Failed to execute mount"),
-                PMLOGKS(LOGKEY_ERRTEXT,gerr->message),
-                "");
-            g_error_free(gerr);
-        }
 
-        if (!resultStatus || exit_status) {
-            LOG_DEBUG("Non-zero exit code from mount.");
-            m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_SMACK, "unable to execute mount command");
-            m_parentTask->proceed();
-            return false;
-        }
-    }
+    CallChain& callchain = CallChain::acquire(std::bind(&RemoveSmackStep::onSmackRemoved,
+        this, _1, _2));
 
-    index = 0;
-    argv[index++] = (gchar *)SMACKCTL_EXEC;
-    argv[index++] = (gchar *)"apply";
-    argv[index++] = NULL;
-    LOG_DEBUG("Executing %s %s", argv[0], argv[1]);
-    resultStatus = g_spawn_sync(NULL,
-                                argv,
-                                NULL,
-                                flags,
-                                NULL,
-                                NULL,
-                                NULL,
-                                NULL,
-                                &exit_status,
-                                &gerr);
-    LOG_DEBUG("smackctl result status is %d, exit status is %d", (int)resultStatus, (int)WEXITSTATUS(exit_status));
-
-    if (gerr) {
-        LOG_ERROR(MSGID_INSTALL_SMACK_FAIL, 2,
-            PMLOGKS(REASON, "Failed to execute smackctl"),
-            PMLOGKS(LOGKEY_ERRTEXT,gerr->message),
-            "");
-        g_error_free(gerr);
+    if (prefix == SMACK_RULES_OVERLAY) {
+        callchain.add(std::make_shared<CallChainEventHandler::RunCommand>(
+            std::vector<std::string>({ "mount", "-o", "remount", Settings::instance().getSmackRulesDir() }),
+            "unable to execute mount command"));
     }
 
-    if (!resultStatus || exit_status) {
-        LOG_DEBUG("Non-zero exit code from smackctl.");
-        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_SMACK, "unable to execute smackctl command");
-        m_parentTask->proceed();
-        return false;
+    callchain.add(std::make_shared<CallChainEventHandler::ApplySmackRules>());
+
+    m_parentTask->setStep(RemoveSmackRequested);
+    callchain.run();
+    return true;
+}
+
+bool RemoveSmackStep::onSmackRemoved(pbnjson::JValue result, void *user_data)
+{
+    LOG_DEBUG("RemoveSmackStep::onSmackRemoved() called\n");
+
+    if (!result["returnValue"].asBool()) {
+        std::string errorText = result["errorText"].asString();
+
+        LOG_ERROR(MSGID_REMOVE_SMACK_FAIL, 2,
+                  PMLOGKS(APP_ID, m_parentTask->getAppId().c_str()),
+                  PMLOGKS(LOGKEY_ERRTEXT, errorText.c_str()),
+                  "");
+        m_parentTask->setError(ErrorInstall, APP_INSTALL_ERR_SMACK, std::move(errorText));
+    } else {
+        m_parentTask->setStep(RemoveSmackComplete);
     }
 
-    m_parentTask->setStep(RemoveSmackComplete);
     m_parentTask->proceed();
     return true;
 }
-
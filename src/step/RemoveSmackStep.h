@@ -17,6 +17,8 @@
 #ifndef REMOVE_SMACK_STEP_H
 #define REMOVE_SMACK_STEP_H
 
+#include <pbnjson.hpp>
+
 #include "Step.h"
 
 class Task;
@@ -26,6 +28,10 @@ public:
     virtual ~RemoveSmackStep();
 
     virtual bool proceed(Task * task);
+
+protected:
+    //! It's called when SMACK rules are reloaded
+    bool onSmackRemoved(pbnjson::JValue result, void *user_data);
 };
 
 #endif
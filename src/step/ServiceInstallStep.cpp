@@ -50,20 +50,14 @@ bool ServiceInstallStep::proceed(Task *task)
     if (!DeviceId::isInternal(targetInfo["deviceId"].asString()))
         isExtStorage = true;
 
-    const char *getLunaUnifiedRolesDir = Settings::instance().getLunaUnifiedRolesDir(verify);
-    const char *getLunaUnifiedServicesDir = Settings::instance().getLunaUnifiedServicesDir(verify);
-    const char *getLunaUnifiedPermissionsDirExternal = Settings::instance().getLunaUnifiedPermissionsDir(verify, false);
-    const char *getLunaUnifiedPermissionsDirInternal = Settings::instance().getLunaUnifiedPermissionsDir(verify, true);
-    const char *getLunaUnifiedAPIPermissionsDir = Settings::instance().getLunaUnifiedAPIPermissionsDir(verify);
-    const char *getLunaUnifiedGroupsDir =  Settings::instance().getLunaUnifiedGroupsDir(verify);
-    const char *getLunaUnifiedManifestsDirExternal = Settings::instance().getLunaUnifiedManifestsDir(verify, false);
-    const char *getLunaUnifiedManifestsDirInternal = Settings::instance().getLunaUnifiedManifestsDir(verify, true);
-
-    if(getLunaUnifiedRolesDir == NULL || getLunaUnifiedServicesDir == NULL || getLunaUnifiedPermissionsDirInternal == NULL || getLunaUnifiedPermissionsDirExternal == NULL || getLunaUnifiedAPIPermissionsDir == NULL || getLunaUnifiedGroupsDir == NULL || getLunaUnifiedManifestsDirInternal == NULL || getLunaUnifiedManifestsDirExternal ==NULL)
-    {
-        LOG_DEBUG("[ServiceInstallStep::proceed] failed  :");
-        return false;
-    }
+    std::string getLunaUnifiedRolesDir = Settings::instance().getLunaUnifiedRolesDir(verify);
+    std::string getLunaUnifiedServicesDir = Settings::instance().getLunaUnifiedServicesDir(verify);
+    std::string getLunaUnifiedPermissionsDirExternal = Settings::instance().getLunaUnifiedPermissionsDir(verify, false);
+    std::string getLunaUnifiedPermissionsDirInternal = Settings::instance().getLunaUnifiedPermissionsDir(verify, true);
+    std::string getLunaUnifiedAPIPermissionsDir = Settings::instance().getLunaUnifiedAPIPermissionsDir(verify);
+    std::string getLunaUnifiedGroupsDir =  Settings::instance().getLunaUnifiedGroupsDir(verify);
+    std::string getLunaUnifiedManifestsDirExternal = Settings::instance().getLunaUnifiedManifestsDir(verify, false);
+    std::string getLunaUnifiedManifestsDirInternal = Settings::instance().getLunaUnifiedManifestsDir(verify, true);
 
     if(isExtStorage && verify)
     {
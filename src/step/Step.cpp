@@ -24,3 +24,8 @@ Step::Step()
 Step::~Step()
 {
 }
+
+bool Step::cancel()
+{
+    return false;
+}
@@ -36,6 +36,12 @@ public:
     //! Proceed each step
     virtual bool proceed(Task *task) = 0;
 
+    /*! Cancel current work of step
+     * Returns true if the work is stopped and step won't proceed task anymore.
+     * Otherwise task is canceled when step proceeds task next time.
+     */
+    virtual bool cancel();
+
 protected:
 
     std::string m_appId;
@@ -0,0 +1,150 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <boost/algorithm/string.hpp>
+#include <glib.h>
+#include <stdio.h>
+#include <sys/resource.h>
+
+#include "base/JUtil.h"
+#include "installer/AppInstaller.h"
+#include "TestEnv.h"
+#include "Workload.h"
+
+static Workload::Options options;
+static gchar *workloads = NULL;
+static gchar *output = NULL;
+
+static GOptionEntry entries[] = {
+    { "tasks", 'n', 0, G_OPTION_ARG_INT, &options.tasks, "Number of apps installed and removed by each workload", "N" },
+    { "ipk-size", 's', 0, G_OPTION_ARG_INT64, &options.ipkSize, "Payload size in bytes of each ipk", "BYTES" },
+    { "files", 'f', 0, G_OPTION_ARG_INT, &options.files, "Number of payload files in each ipk", "N" },
+    { "services", 'v', 0, G_OPTION_ARG_INT, &options.services, "Number of services in each ipk", "N" },
+    { "concurrency", 'c', 0, G_OPTION_ARG_INT, &options.concurrency, "maxConcurrentTasks of concurrent and batched workloads", "N" },
+    { "latency", 'l', 0, G_OPTION_ARG_INT, &options.latency, "Delay in ms of fake luna-service replies", "MS" },
+    { "timeout", 't', 0, G_OPTION_ARG_INT, &options.timeout, "Timeout in ms of each install or remove phase", "MS" },
+    { "workloads", 'w', 0, G_OPTION_ARG_STRING, &workloads, "Comma separated workloads, serial,concurrent,batched by default", "LIST" },
+    { "output", 'o', 0, G_OPTION_ARG_FILENAME, &output, "Write JSON results to file instead of stdout", "FILE" },
+    { NULL }
+};
+
+static bool parseWorkloads(const std::string &list, std::vector<Workload::Type> &types)
+{
+    std::vector<std::string> names;
+    boost::split(names, list, boost::is_any_of(","), boost::token_compress_on);
+
+    for (const auto &name : names) {
+        bool found = false;
+        for (Workload::Type type : { Workload::SERIAL, Workload::CONCURRENT, Workload::BATCHED }) {
+            if (name == Workload::toString(type)) {
+                types.push_back(type);
+                found = true;
+            }
+        }
+
+        if (!found) {
+            fprintf(stderr, "Unknown workload: %s\n", name.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    GError *gerr = NULL;
+    GOptionContext *context = g_option_context_new("- install/remove benchmark of appinstalld with fake bus and tools");
+    g_option_context_add_main_entries(context, entries, NULL);
+    if (!g_option_context_parse(context, &argc, &argv, &gerr)) {
+        fprintf(stderr, "%s\n", gerr->message);
+        g_error_free(gerr);
+        g_option_context_free(context);
+        return 1;
+    }
+    g_option_context_free(context);
+
+    std::vector<Workload::Type> types;
+    if (!parseWorkloads(workloads ? workloads : "serial,concurrent,batched", types))
+        return 1;
+
+    if (options.tasks < 1 || options.ipkSize < 0 || options.files < 0 || options.services < 0 || options.concurrency < 1) {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    std::string errorText;
+    if (!testRoot().setUp(errorText)) {
+        fprintf(stderr, "Failed to set up test root: %s\n", errorText.c_str());
+        return 1;
+    }
+
+    fakeBus().attach();
+    if (!AppInstaller::instance().initialize()) {
+        fprintf(stderr, "Failed to initialize AppInstaller\n");
+        return 1;
+    }
+
+    int result = 0;
+    pbnjson::JValue results = pbnjson::Array();
+    for (Workload::Type type : types) {
+        Workload workload(type, options);
+
+        // ipks are generated out of measurement
+        if (!workload.prepare(errorText) || !workload.run(errorText)) {
+            fprintf(stderr, "Workload %s failed: %s\n", Workload::toString(type), errorText.c_str());
+            result = 1;
+            break;
+        }
+
+        results.append(workload.toJValue());
+    }
+
+    pbnjson::JValue config = pbnjson::Object();
+    config.put("tasks", options.tasks);
+    config.put("ipkSize", options.ipkSize);
+    config.put("files", options.files);
+    config.put("services", options.services);
+    config.put("concurrency", options.concurrency);
+    config.put("latency", options.latency);
+
+    pbnjson::JValue report = pbnjson::Object();
+    report.put("config", config);
+    report.put("results", results);
+
+    // whole run of this process, it's not attributed to any workload
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        report.put("processMaxRss", (int64_t) usage.ru_maxrss);
+
+    std::string json = JUtil::toSimpleString(report);
+    FILE *file = output ? fopen(output, "w") : stdout;
+    if (!file) {
+        fprintf(stderr, "Failed to open %s\n", output);
+        result = 1;
+    } else {
+        fprintf(file, "%s\n", json.c_str());
+        if (file != stdout)
+            fclose(file);
+    }
+
+    AppInstaller::instance().finalize();
+    fakeBus().detach();
+    testRoot().tearDown();
+    g_free(workloads);
+    g_free(output);
+    return result;
+}
@@ -0,0 +1,259 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Workload.h"
+
+#include <algorithm>
+#include <glib.h>
+#include <map>
+
+#include "base/Utils.h"
+#include "installer/AppInstaller.h"
+#include "installer/InstallHistory.h"
+#include "IpkBuilder.h"
+#include "settings/Settings.h"
+#include "TestEnv.h"
+
+#define BENCH_CLIENT    "com.example.bench"
+
+//! nearest rank percentile of sorted values
+static int64_t percentile(const std::vector<int64_t> &sorted, int percent)
+{
+    if (sorted.empty())
+        return 0;
+    size_t rank = (sorted.size() * percent + 99) / 100;
+    return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+//! p50/p99/max of values in us, reported in ms
+static pbnjson::JValue toLatency(std::vector<int64_t> values)
+{
+    std::sort(values.begin(), values.end());
+
+    pbnjson::JValue json = pbnjson::Object();
+    json.put("p50", percentile(values, 50) / 1000.0);
+    json.put("p99", percentile(values, 99) / 1000.0);
+    json.put("max", values.empty() ? 0 : values.back() / 1000.0);
+    return json;
+}
+
+static pbnjson::JValue makeAppInfo(const std::string &appId)
+{
+    pbnjson::JValue details = pbnjson::Object();
+    details.put("client", BENCH_CLIENT);
+
+    pbnjson::JValue appInfo = pbnjson::Object();
+    appInfo.put("id", appId);
+    appInfo.put("details", details);
+    return appInfo;
+}
+
+Workload::Workload(Type type, const Options &options)
+    : m_type(type),
+      m_options(options),
+      m_installWallTime(0),
+      m_removeWallTime(0)
+{
+}
+
+const char* Workload::toString(Type type)
+{
+    switch (type) {
+    case SERIAL:
+        return "serial";
+    case CONCURRENT:
+        return "concurrent";
+    case BATCHED:
+        return "batched";
+    }
+
+    return "unknown";
+}
+
+bool Workload::prepare(std::string &errorText)
+{
+    std::string ipkDir = testRoot().getPath() + "/ipk/" + toString(m_type);
+    if (!Utils::make_dir(ipkDir)) {
+        errorText = "unable to create " + ipkDir;
+        return false;
+    }
+
+    m_appIds.clear();
+    m_ipkPaths.clear();
+
+    for (int i = 0; i < m_options.tasks; ++i) {
+        std::string appId = std::string("com.example.bench.") + toString(m_type) + std::to_string(i);
+        std::string ipkPath = ipkDir + "/" + appId + "_1.0.0_all.ipk";
+
+        IpkBuilder builder(appId);
+        builder.setServiceCount(m_options.services);
+        if (m_options.files > 0)
+            builder.setPayload(m_options.files, m_options.ipkSize);
+
+        if (!builder.write(ipkPath, errorText))
+            return false;
+
+        m_appIds.push_back(std::move(appId));
+        m_ipkPaths.push_back(std::move(ipkPath));
+    }
+
+    return true;
+}
+
+bool Workload::run(std::string &errorText)
+{
+    // both of them are read on the fly, so they're applied to tasks made after this
+    pbnjson::JValue conf = pbnjson::Object();
+    conf.put("maxConcurrentTasks", m_type == SERIAL ? 1 : m_options.concurrency);
+    conf.put("opkgBatchInstall", m_type == BATCHED);
+    if (!testRoot().reconfigure(conf, errorText))
+        return false;
+
+    fakeBus().setLatency(m_options.latency);
+    fakeBus().clear();
+
+    TaskRunner runner;
+
+    int64_t start = g_get_monotonic_time();
+    if (!install(runner, errorText))
+        return false;
+    m_installWallTime = g_get_monotonic_time() - start;
+    m_installResults = runner.getResults();
+    runner.clear();
+
+    // emulated applicationManager knows installed apps
+    for (const auto &appId : m_appIds) {
+        pbnjson::JValue appInfo = pbnjson::Object();
+        appInfo.put("id", appId);
+        appInfo.put("removable", true);
+        appInfo.put("folderPath", Settings::instance().getInstallApplicationPath(true) + "/" + appId);
+        fakeBus().setAppInfo(appId, appInfo);
+    }
+
+    start = g_get_monotonic_time();
+    if (!remove(runner, errorText))
+        return false;
+    m_removeWallTime = g_get_monotonic_time() - start;
+    m_removeResults = runner.getResults();
+
+    for (const auto &appId : m_appIds)
+        fakeBus().removeAppInfo(appId);
+
+    return true;
+}
+
+bool Workload::install(TaskRunner &runner, std::string &errorText)
+{
+    int errorCode = 0;
+
+    if (m_type == BATCHED) {
+        pbnjson::JValue packages = pbnjson::Array();
+        for (size_t i = 0; i < m_appIds.size(); ++i) {
+            pbnjson::JValue package = pbnjson::Object();
+            package.put("id", m_appIds[i]);
+            package.put("ipkUrl", m_ipkPaths[i]);
+            packages.append(package);
+            runner.expect(m_appIds[i]);
+        }
+
+        if (AppInstaller::instance().installBatch(packages, BENCH_CLIENT, errorCode, errorText).empty())
+            return false;
+    } else {
+        for (size_t i = 0; i < m_appIds.size(); ++i) {
+            if (!AppInstaller::instance().install(m_appIds[i], m_ipkPaths[i], makeAppInfo(m_appIds[i]), errorCode, errorText))
+                return false;
+
+            runner.expect(m_appIds[i]);
+            if (m_type == SERIAL && !runner.wait(m_options.timeout)) {
+                errorText = "install of " + m_appIds[i] + " is not finished in time";
+                return false;
+            }
+        }
+    }
+
+    if (!runner.wait(m_options.timeout)) {
+        errorText = "install is not finished in time";
+        return false;
+    }
+
+    return true;
+}
+
+bool Workload::remove(TaskRunner &runner, std::string &errorText)
+{
+    int errorCode = 0;
+
+    // there is no batch remove, batched workload removes apps concurrently
+    for (const auto &appId : m_appIds) {
+        if (!AppInstaller::instance().remove(appId, makeAppInfo(appId), errorCode, errorText))
+            return false;
+
+        runner.expect(appId);
+        if (m_type == SERIAL && !runner.wait(m_options.timeout)) {
+            errorText = "remove of " + appId + " is not finished in time";
+            return false;
+        }
+    }
+
+    if (!runner.wait(m_options.timeout)) {
+        errorText = "remove is not finished in time";
+        return false;
+    }
+
+    return true;
+}
+
+pbnjson::JValue Workload::toJValue() const
+{
+    pbnjson::JValue json = pbnjson::Object();
+    json.put("workload", toString(m_type));
+    json.put("install", summarize(m_installResults, m_installWallTime));
+    json.put("remove", summarize(m_removeResults, m_removeWallTime));
+    return json;
+}
+
+pbnjson::JValue Workload::summarize(const std::vector<TaskRunner::Result> &results, int64_t wallTime)
+{
+    int failed = 0;
+    std::vector<int64_t> latencies;
+    std::map<TaskStep, std::vector<int64_t> > stepTimes;
+
+    for (const auto &result : results) {
+        if (result.errorCode != 0) {
+            ++failed;
+            continue;
+        }
+
+        latencies.push_back(result.finishedTime - result.createdTime);
+
+        // last step is terminal one, task is finished as soon as it's reached
+        for (size_t i = 0; i + 1 < result.stepTimes.size(); ++i)
+            stepTimes[result.stepTimes[i].first].push_back(result.stepTimes[i + 1].second - result.stepTimes[i].second);
+    }
+
+    pbnjson::JValue steps = pbnjson::Object();
+    for (auto &step : stepTimes)
+        steps.put(TaskStepParser::enumToStringStep(step.first), toLatency(std::move(step.second)));
+
+    pbnjson::JValue json = pbnjson::Object();
+    json.put("tasks", (int64_t) results.size());
+    json.put("failed", failed);
+    json.put("wallTime", wallTime / 1000.0);
+    json.put("tasksPerMinute", wallTime > 0 ? (results.size() - failed) * 60000000.0 / wallTime : 0);
+    json.put("latency", toLatency(std::move(latencies)));
+    json.put("steps", steps);
+    return json;
+}
@@ -0,0 +1,98 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <pbnjson.hpp>
+#include <string>
+#include <vector>
+
+#include "TaskRunner.h"
+
+/*! Workload class installs and removes generated ipks through AppInstaller and measures them.
+ * Helper binaries and luna-service bus are fakes, so numbers are cost of appinstalld itself
+ * plus unpacking data.tar.gz, not of opkg, ls-hubd or applicationManager.
+ */
+class Workload {
+public:
+    typedef enum {
+        //! one task at a time, next one is requested when last one is finished
+        SERIAL = 0,
+        //! all tasks requested at once, maxConcurrentTasks of them run in parallel
+        CONCURRENT,
+        //! all installs requested by installBatch, ipks share one opkg run
+        BATCHED
+    } Type;
+
+    struct Options {
+        Options()
+            : tasks(8), ipkSize(1024 * 1024), files(16), services(0), concurrency(4), latency(0), timeout(10 * 60 * 1000) {}
+
+        //! number of apps installed and removed
+        int tasks;
+        //! size of payload in each ipk
+        int64_t ipkSize;
+        //! number of payload files in each ipk
+        int files;
+        //! number of services in each ipk
+        int services;
+        //! maxConcurrentTasks of concurrent and batched workloads
+        int concurrency;
+        //! delay in ms of fake luna-service replies
+        int latency;
+        //! timeout in ms of each phase
+        int timeout;
+    };
+
+    //! Constructor
+    Workload(Type type, const Options &options);
+
+    //! get name of type
+    static const char* toString(Type type);
+
+    //! generate ipks of apps
+    bool prepare(std::string &errorText);
+
+    //! install and remove all apps, it returns false if any of them is not finished
+    bool run(std::string &errorText);
+
+    //! get results of last run
+    pbnjson::JValue toJValue() const;
+
+protected:
+    //! install all apps according to type
+    bool install(TaskRunner &runner, std::string &errorText);
+
+    //! remove all apps according to type
+    bool remove(TaskRunner &runner, std::string &errorText);
+
+    //! summarize results of one phase
+    static pbnjson::JValue summarize(const std::vector<TaskRunner::Result> &results, int64_t wallTime);
+
+private:
+    Type m_type;
+    Options m_options;
+    std::vector<std::string> m_appIds;
+    std::vector<std::string> m_ipkPaths;
+
+    std::vector<TaskRunner::Result> m_installResults;
+    std::vector<TaskRunner::Result> m_removeResults;
+    int64_t m_installWallTime;
+    int64_t m_removeWallTime;
+};
+
+#endif
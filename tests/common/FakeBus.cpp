@@ -0,0 +1,178 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "FakeBus.h"
+
+#include "base/JUtil.h"
+#include "base/Utils.h"
+
+using namespace std::placeholders;
+
+FakeBus::FakeBus()
+    : m_lastToken(0),
+      m_latency(0),
+      m_attached(false)
+{
+    setHandler("luna://com.webos.applicationManager/getAppInfo", std::bind(&FakeBus::onGetAppInfo, this, _1));
+    setHandler("luna://com.webos.applicationManager/running", std::bind(&FakeBus::onRunning, this, _1));
+}
+
+FakeBus::~FakeBus()
+{
+    detach();
+}
+
+void FakeBus::attach()
+{
+    LSUtils::setBus(this);
+    m_attached = true;
+}
+
+void FakeBus::detach()
+{
+    // LSUtils may be gone already if bus is static
+    if (!m_attached)
+        return;
+
+    LSUtils::setBus(nullptr);
+    m_attached = false;
+}
+
+void FakeBus::setHandler(const std::string &uri, FuncHandler handler)
+{
+    m_handlers[uri] = std::move(handler);
+}
+
+void FakeBus::setLatency(unsigned int latency)
+{
+    m_latency = latency;
+}
+
+void FakeBus::setDropCount(const std::string &uri, unsigned int count)
+{
+    m_dropCounts[uri] = count;
+}
+
+void FakeBus::setAppInfo(const std::string &appId, pbnjson::JValue appInfo)
+{
+    m_apps[appId] = std::move(appInfo);
+}
+
+void FakeBus::removeAppInfo(const std::string &appId)
+{
+    m_apps.erase(appId);
+}
+
+const std::vector<FakeBus::Call>& FakeBus::getCalls() const
+{
+    return m_calls;
+}
+
+std::vector<std::string> FakeBus::getReplies(const std::string &key) const
+{
+    auto it = m_replies.find(key);
+    if (it == m_replies.end())
+        return std::vector<std::string>();
+
+    return it->second;
+}
+
+void FakeBus::clear()
+{
+    m_calls.clear();
+    m_replies.clear();
+    m_dropCounts.clear();
+}
+
+bool FakeBus::call(const std::string &uri,
+                   const std::string &payload,
+                   FuncReply onReply,
+                   LSMessageToken &token,
+                   std::string &errorText)
+{
+    m_calls.push_back(Call { uri, payload });
+
+    token = ++m_lastToken;
+    m_pendingTokens.insert(token);
+
+    // dropped call is pending until caller cancels it
+    auto drop = m_dropCounts.find(uri);
+    if (drop != m_dropCounts.end() && drop->second > 0) {
+        --drop->second;
+        return true;
+    }
+
+    std::string reply = "{\"returnValue\":true}";
+    auto it = m_handlers.find(uri);
+    if (it != m_handlers.end())
+        reply = it->second(payload);
+
+    LSMessageToken replyToken = token;
+    Utils::async([this, replyToken, reply, onReply] {
+        // canceled call isn't replied
+        if (m_pendingTokens.erase(replyToken) == 0)
+            return;
+
+        if (onReply)
+            onReply(reply.c_str(), false);
+    }, m_latency);
+
+    return true;
+}
+
+bool FakeBus::cancel(LSMessageToken token, std::string &errorText)
+{
+    if (m_pendingTokens.erase(token) == 0) {
+        errorText = "unknown token";
+        return false;
+    }
+
+    return true;
+}
+
+bool FakeBus::replySubscription(const std::string &key, const std::string &payload)
+{
+    m_replies[key].push_back(payload);
+    return true;
+}
+
+std::string FakeBus::onGetAppInfo(const std::string &payload)
+{
+    pbnjson::JValue request = JUtil::parseTrusted(payload.c_str());
+    pbnjson::JValue reply = pbnjson::Object();
+
+    auto it = m_apps.find(request["id"].asString());
+    if (it == m_apps.end()) {
+        reply.put("returnValue", false);
+        reply.put("errorText", "Cannot find proper launchPoint");
+    } else {
+        reply.put("returnValue", true);
+        reply.put("appId", it->first);
+        reply.put("appInfo", it->second);
+    }
+
+    return JUtil::toSimpleString(std::move(reply));
+}
+
+std::string FakeBus::onRunning(const std::string &payload)
+{
+    // nothing runs in process
+    pbnjson::JValue reply = pbnjson::Object();
+    reply.put("returnValue", true);
+    reply.put("running", pbnjson::Array());
+
+    return JUtil::toSimpleString(std::move(reply));
+}
@@ -0,0 +1,109 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef FAKEBUS_H
+#define FAKEBUS_H
+
+#include <functional>
+#include <map>
+#include <pbnjson.hpp>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/LSUtils.h"
+
+/*! FakeBus class answers luna-service calls of appinstalld in process.
+ * Replies are made by handler registered for uri, or {"returnValue":true} by default,
+ * and delivered from main loop after latency like ls-hubd does.
+ * com.webos.applicationManager is emulated by apps set with setAppInfo.
+ * Subscription replies are recorded per key, so status published by tasks can be checked.
+ */
+class FakeBus : public LSBus {
+public:
+    //! It returns reply payload for request payload
+    typedef std::function<std::string (const std::string &payload)> FuncHandler;
+
+    struct Call {
+        std::string uri;
+        std::string payload;
+    };
+
+    //! Constructor
+    FakeBus();
+
+    //! Destructor
+    virtual ~FakeBus();
+
+    //! Route calls of LSCaller to this bus
+    void attach();
+
+    //! Restore LSCaller to registered services
+    void detach();
+
+    //! Set handler of uri
+    void setHandler(const std::string &uri, FuncHandler handler);
+
+    //! Set delay in ms before reply is delivered
+    void setLatency(unsigned int latency);
+
+    //! Don't reply first count calls of uri, as if hub lost them
+    void setDropCount(const std::string &uri, unsigned int count);
+
+    //! Add app known by emulated applicationManager
+    void setAppInfo(const std::string &appId, pbnjson::JValue appInfo);
+
+    //! Remove app known by emulated applicationManager
+    void removeAppInfo(const std::string &appId);
+
+    //! Get calls sent to this bus
+    const std::vector<Call>& getCalls() const;
+
+    //! Get payloads replied to subscribers of key
+    std::vector<std::string> getReplies(const std::string &key) const;
+
+    //! Clear recorded calls and replies
+    void clear();
+
+    // LSBus
+    virtual bool call(const std::string &uri,
+                      const std::string &payload,
+                      FuncReply onReply,
+                      LSMessageToken &token,
+                      std::string &errorText) override;
+    virtual bool cancel(LSMessageToken token, std::string &errorText) override;
+    virtual bool replySubscription(const std::string &key, const std::string &payload) override;
+
+private:
+    //! reply of emulated com.webos.applicationManager/getAppInfo
+    std::string onGetAppInfo(const std::string &payload);
+
+    //! reply of emulated com.webos.applicationManager/running
+    std::string onRunning(const std::string &payload);
+
+private:
+    std::map<std::string, FuncHandler> m_handlers;
+    std::map<std::string, unsigned int> m_dropCounts;
+    std::map<std::string, pbnjson::JValue> m_apps;
+    std::vector<Call> m_calls;
+    std::map<std::string, std::vector<std::string> > m_replies;
+    std::set<LSMessageToken> m_pendingTokens;
+    LSMessageToken m_lastToken;
+    unsigned int m_latency;
+    bool m_attached;
+};
+
+#endif
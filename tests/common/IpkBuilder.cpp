@@ -0,0 +1,295 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "IpkBuilder.h"
+
+#include <fstream>
+#include <pbnjson.hpp>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <zlib.h>
+
+#include "base/JUtil.h"
+#include "base/Utils.h"
+
+#define TAR_BLOCK_SIZE      512
+#define GZIP_CHUNK_SIZE     16384
+
+IpkBuilder::IpkBuilder(std::string appId, std::string version)
+    : m_appId(std::move(appId)),
+      m_version(std::move(version)),
+      m_serviceCount(0),
+      m_payloadFiles(0),
+      m_payloadSize(0)
+{
+}
+
+IpkBuilder& IpkBuilder::setServiceCount(size_t count)
+{
+    m_serviceCount = count;
+    return *this;
+}
+
+IpkBuilder& IpkBuilder::setPayload(size_t fileCount, size_t totalSize)
+{
+    m_payloadFiles = fileCount;
+    m_payloadSize = totalSize;
+    return *this;
+}
+
+IpkBuilder& IpkBuilder::addFile(const std::string &name, const std::string &content)
+{
+    m_files.emplace_back(name, content);
+    return *this;
+}
+
+std::vector<std::string> IpkBuilder::getServiceIds() const
+{
+    std::vector<std::string> serviceIds;
+    for (size_t i = 0; i < m_serviceCount; ++i)
+        serviceIds.push_back(m_appId + ".service" + std::to_string(i));
+    return serviceIds;
+}
+
+bool IpkBuilder::write(const std::string &path, std::string &errorText) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        errorText = "unable to open " + path;
+        return false;
+    }
+
+    std::string ipk = build();
+    file.write(ipk.data(), ipk.size());
+    file.close();
+
+    if (file.fail()) {
+        errorText = "unable to write " + path;
+        return false;
+    }
+
+    return true;
+}
+
+std::string IpkBuilder::build() const
+{
+    std::string data;
+    for (const auto &entry : getDataEntries())
+        appendTarEntry(data, entry.name, entry.content, entry.type);
+    finishTar(data);
+
+    std::string control;
+    appendTarEntry(control, "./control",
+                   "Package: " + m_appId + "\n"
+                   "Version: " + m_version + "\n"
+                   "Section: misc\n"
+                   "Priority: optional\n"
+                   "Architecture: all\n"
+                   "Installed-Size: " + std::to_string(data.size() / 1024 + 1) + "\n"
+                   "Maintainer: N/A <nobody@example.com>\n"
+                   "Description: " + m_appId + "\n"
+                   "webOS-Package-Format-Version: 2\n"
+                   "webOS-Packager-Version: x.y.x\n");
+    finishTar(control);
+
+    std::string ipk = "!<arch>\n";
+    appendArMember(ipk, "debian-binary", "2.0\n");
+    appendArMember(ipk, "control.tar.gz", gzip(control));
+    appendArMember(ipk, "data.tar.gz", gzip(data));
+
+    return ipk;
+}
+
+std::vector<IpkBuilder::Entry> IpkBuilder::getDataEntries() const
+{
+    std::string appDir = "./usr/palm/applications/" + m_appId;
+    std::vector<std::string> serviceIds = getServiceIds();
+    std::vector<Entry> entries;
+
+    entries.push_back({ "./usr/", "", '5' });
+    entries.push_back({ "./usr/palm/", "", '5' });
+    entries.push_back({ "./usr/palm/applications/", "", '5' });
+    entries.push_back({ appDir + "/", "", '5' });
+
+    pbnjson::JValue appInfo = pbnjson::Object();
+    appInfo.put("id", m_appId);
+    appInfo.put("version", m_version);
+    appInfo.put("vendor", "LG Electronics");
+    appInfo.put("type", "web");
+    appInfo.put("main", "index.html");
+    appInfo.put("title", m_appId);
+    entries.push_back({ appDir + "/appinfo.json", JUtil::toSimpleString(appInfo), '0' });
+    entries.push_back({ appDir + "/index.html", "<html><body>" + m_appId + "</body></html>\n", '0' });
+
+    for (const auto &file : m_files)
+        entries.push_back({ appDir + "/" + file.first, file.second, '0' });
+
+    // random bytes don't compress, so ipk size follows payload size
+    std::mt19937 generator(m_payloadFiles);
+    for (size_t i = 0; i < m_payloadFiles; ++i) {
+        std::string content(m_payloadSize / m_payloadFiles, '\0');
+        for (auto &c : content)
+            c = static_cast<char>(generator());
+        entries.push_back({ appDir + "/payload" + std::to_string(i) + ".bin", std::move(content), '0' });
+    }
+
+    if (serviceIds.empty())
+        return entries;
+
+    std::string packageDir = "./usr/palm/packages/" + m_appId;
+    entries.push_back({ "./usr/palm/packages/", "", '5' });
+    entries.push_back({ packageDir + "/", "", '5' });
+    entries.push_back({ "./usr/palm/services/", "", '5' });
+
+    pbnjson::JValue services = pbnjson::Array();
+    for (const auto &serviceId : serviceIds)
+        services.append(serviceId);
+
+    pbnjson::JValue packageInfo = pbnjson::Object();
+    packageInfo.put("id", m_appId);
+    packageInfo.put("version", m_version);
+    packageInfo.put("app", m_appId);
+    packageInfo.put("services", services);
+    entries.push_back({ packageDir + "/packageinfo.json", JUtil::toSimpleString(packageInfo), '0' });
+
+    for (const auto &serviceId : serviceIds) {
+        std::string serviceDir = "./usr/palm/services/" + serviceId;
+
+        pbnjson::JValue command = pbnjson::Object();
+        command.put("name", "hello");
+        command.put("description", "say hello");
+        command.put("public", true);
+
+        pbnjson::JValue service = pbnjson::Object();
+        service.put("name", serviceId);
+        service.put("description", "generated service");
+        service.put("Commands", pbnjson::Array() << command);
+
+        pbnjson::JValue servicesJson = pbnjson::Object();
+        servicesJson.put("id", serviceId);
+        servicesJson.put("description", "generated service");
+        servicesJson.put("engine", "node");
+        servicesJson.put("executable", "service.js");
+        servicesJson.put("services", pbnjson::Array() << service);
+
+        entries.push_back({ serviceDir + "/", "", '5' });
+        entries.push_back({ serviceDir + "/services.json", JUtil::toSimpleString(servicesJson), '0' });
+        entries.push_back({ serviceDir + "/service.js", "require('webos-service');\n", '0' });
+    }
+
+    return entries;
+}
+
+bool IpkBuilder::unpack(const std::string &basePath, std::string &errorText) const
+{
+    for (const auto &entry : getDataEntries()) {
+        std::string path = basePath + "/" + entry.name;
+
+        if (entry.type == '5') {
+            if (!Utils::make_dir(path)) {
+                errorText = "unable to create " + path;
+                return false;
+            }
+            continue;
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(entry.content.data(), entry.content.size());
+        file.close();
+
+        if (file.fail()) {
+            errorText = "unable to write " + path;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void IpkBuilder::appendTarEntry(std::string &tar, const std::string &name, const std::string &content, char type)
+{
+    char header[TAR_BLOCK_SIZE];
+    memset(header, 0, sizeof(header));
+
+    strncpy(header, name.c_str(), 99);
+    snprintf(header + 100, 8, "%07o", type == '5' ? 0755 : 0644);
+    snprintf(header + 108, 8, "%07o", 0);
+    snprintf(header + 116, 8, "%07o", 0);
+    snprintf(header + 124, 12, "%011llo", (unsigned long long) content.size());
+    snprintf(header + 136, 12, "%011o", 0);
+    header[156] = type;
+    memcpy(header + 257, "ustar", 6);
+    memcpy(header + 263, "00", 2);
+
+    // checksum is computed with its own field filled by spaces
+    memset(header + 148, ' ', 8);
+    unsigned int checksum = 0;
+    for (size_t i = 0; i < sizeof(header); ++i)
+        checksum += static_cast<unsigned char>(header[i]);
+    snprintf(header + 148, 8, "%06o", checksum);
+
+    tar.append(header, sizeof(header));
+    tar.append(content);
+    tar.append((TAR_BLOCK_SIZE - content.size() % TAR_BLOCK_SIZE) % TAR_BLOCK_SIZE, '\0');
+}
+
+void IpkBuilder::finishTar(std::string &tar)
+{
+    tar.append(TAR_BLOCK_SIZE * 2, '\0');
+}
+
+void IpkBuilder::appendArMember(std::string &ar, const std::string &name, const std::string &content)
+{
+    char header[61];
+    snprintf(header, sizeof(header), "%-16s%-12d%-6d%-6d%-8o%-10zu`\n",
+             (name + "/").c_str(), 0, 0, 0, 0100644, content.size());
+
+    ar.append(header, 60);
+    ar.append(content);
+    // member data is aligned to even byte
+    if (content.size() & 1)
+        ar.append("\n");
+}
+
+std::string IpkBuilder::gzip(const std::string &data)
+{
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // 16 + MAX_WBITS : gzip header
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return std::string();
+
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in = data.size();
+
+    std::string result;
+    char out[GZIP_CHUNK_SIZE];
+    int zresult = Z_OK;
+    while (zresult != Z_STREAM_END) {
+        stream.next_out = reinterpret_cast<Bytef*>(out);
+        stream.avail_out = sizeof(out);
+
+        zresult = deflate(&stream, Z_FINISH);
+        if (zresult == Z_STREAM_ERROR)
+            break;
+
+        result.append(out, sizeof(out) - stream.avail_out);
+    }
+
+    deflateEnd(&stream);
+    return result;
+}
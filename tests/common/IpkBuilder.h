@@ -0,0 +1,86 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef IPKBUILDER_H
+#define IPKBUILDER_H
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/*! IpkBuilder class generates ipk of web app in process, same layout as ares-package.
+ * It's ar archive of debian-binary, control.tar.gz and data.tar.gz, data is relative to /.
+ * Size of the package is controlled by payload files of random content, which don't compress.
+ */
+class IpkBuilder {
+public:
+    //! file or directory(type '5') of data member, name is relative to /
+    struct Entry {
+        std::string name;
+        std::string content;
+        char type;
+    };
+
+    //! Constructor
+    IpkBuilder(std::string appId, std::string version = "1.0.0");
+
+    //! Add services, their ids are appId + ".service" + index
+    IpkBuilder& setServiceCount(size_t count);
+
+    //! Add payload files to app directory, total size is split evenly
+    IpkBuilder& setPayload(size_t fileCount, size_t totalSize);
+
+    //! Add file to app directory
+    IpkBuilder& addFile(const std::string &name, const std::string &content);
+
+    //! Get service ids
+    std::vector<std::string> getServiceIds() const;
+
+    //! Write ipk file
+    bool write(const std::string &path, std::string &errorText) const;
+
+    //! Get contents of the ipk
+    std::string build() const;
+
+    //! Get entries of data member
+    std::vector<Entry> getDataEntries() const;
+
+    //! Write entries of data member under basePath, same as opkg unpacks it
+    bool unpack(const std::string &basePath, std::string &errorText) const;
+
+protected:
+    //! Append ustar entry of regular file or directory(type '5')
+    static void appendTarEntry(std::string &tar, const std::string &name, const std::string &content, char type = '0');
+
+    //! Append end of archive blocks
+    static void finishTar(std::string &tar);
+
+    //! Append ar member
+    static void appendArMember(std::string &ar, const std::string &name, const std::string &content);
+
+    //! Compress data to gzip stream
+    static std::string gzip(const std::string &data);
+
+private:
+    std::string m_appId;
+    std::string m_version;
+    size_t m_serviceCount;
+    size_t m_payloadFiles;
+    size_t m_payloadSize;
+    std::vector<std::pair<std::string, std::string> > m_files;
+};
+
+#endif
@@ -0,0 +1,100 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TaskRunner.h"
+
+#include <functional>
+
+#include "installer/AppInstaller.h"
+
+TaskRunner::TaskRunner()
+    : m_loop(g_main_loop_new(NULL, FALSE))
+{
+    m_connection = AppInstaller::instance().signalFinished.connect(
+        std::bind(&TaskRunner::onFinished, this, std::placeholders::_1));
+}
+
+TaskRunner::~TaskRunner()
+{
+    m_connection.disconnect();
+    g_main_loop_unref(m_loop);
+}
+
+void TaskRunner::expect(const std::string &appId)
+{
+    m_waiting.insert(appId);
+}
+
+bool TaskRunner::wait(unsigned int timeout)
+{
+    if (m_waiting.empty())
+        return true;
+
+    guint timer = g_timeout_add(timeout, cbTimeout, this);
+    g_main_loop_run(m_loop);
+
+    if (!m_waiting.empty()) {
+        m_waiting.clear();
+        return false;
+    }
+
+    g_source_remove(timer);
+    return true;
+}
+
+const std::vector<TaskRunner::Result>& TaskRunner::getResults() const
+{
+    return m_results;
+}
+
+const TaskRunner::Result* TaskRunner::getResult(const std::string &appId) const
+{
+    for (const auto &result : m_results) {
+        if (result.appId == appId)
+            return &result;
+    }
+
+    return nullptr;
+}
+
+void TaskRunner::clear()
+{
+    m_results.clear();
+}
+
+void TaskRunner::onFinished(const Task &task)
+{
+    Result result;
+    result.appId = task.getAppId();
+    result.name = task.getName();
+    result.stepTimes = task.getStepTimes();
+    result.errorCode = task.getErrorCode();
+    result.errorText = task.getErrorText();
+    result.status = task.getStatusString();
+    result.createdTime = task.getCreatedTime();
+    result.finishedTime = g_get_monotonic_time();
+    m_results.push_back(std::move(result));
+
+    if (m_waiting.erase(task.getAppId()) && m_waiting.empty())
+        g_main_loop_quit(m_loop);
+}
+
+gboolean TaskRunner::cbTimeout(gpointer data)
+{
+    TaskRunner *runner = static_cast<TaskRunner*>(data);
+    g_main_loop_quit(runner->m_loop);
+    return G_SOURCE_REMOVE;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TASKRUNNER_H
+#define TASKRUNNER_H
+
+#include <boost/signals2.hpp>
+#include <glib.h>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "installer/Task.h"
+
+/*! TaskRunner class runs main loop until tasks of AppInstaller are finished.
+ * Results are copied when task is finished, because task is released right after it.
+ */
+class TaskRunner {
+public:
+    struct Result {
+        std::string appId;
+        std::string name;
+        Task::StepTimes stepTimes;
+        int errorCode;
+        std::string errorText;
+        std::string status;
+        //! monotonic time in us when task is created and finished
+        int64_t createdTime;
+        int64_t finishedTime;
+    };
+
+    //! Constructor
+    TaskRunner();
+
+    //! Destructor
+    ~TaskRunner();
+
+    //! Add appId of task to wait for
+    void expect(const std::string &appId);
+
+    //! Run main loop until expected tasks are finished, false if timeout in ms is expired
+    bool wait(unsigned int timeout);
+
+    //! Get results in finished order
+    const std::vector<Result>& getResults() const;
+
+    //! Get result of appId, nullptr if it's not finished
+    const Result* getResult(const std::string &appId) const;
+
+    //! Clear results
+    void clear();
+
+protected:
+    //! It's called when Task finished
+    void onFinished(const Task &task);
+
+    //! It's called when wait is expired
+    static gboolean cbTimeout(gpointer data);
+
+private:
+    GMainLoop *m_loop;
+    boost::signals2::connection m_connection;
+    std::set<std::string> m_waiting;
+    std::vector<Result> m_results;
+};
+
+#endif
@@ -0,0 +1,29 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TESTENV_H
+#define TESTENV_H
+
+#include "FakeBus.h"
+#include "TestRoot.h"
+
+//! temporary root shared by tests and benchmarks, it's set up in main() before Settings is used
+TestRoot& testRoot();
+
+//! fake bus shared by tests and benchmarks, it's attached to LSUtils in main()
+FakeBus& fakeBus();
+
+#endif
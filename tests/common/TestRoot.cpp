@@ -0,0 +1,182 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TestRoot.h"
+
+#include <fstream>
+#include <glib.h>
+#include <stdlib.h>
+
+#include "base/JUtil.h"
+#include "base/Utils.h"
+#include "settings/Settings.h"
+
+TestRoot::TestRoot()
+{
+}
+
+TestRoot::~TestRoot()
+{
+    tearDown();
+}
+
+bool TestRoot::setUp(std::string &errorText, pbnjson::JValue overrides)
+{
+    // smack labels are written as user xattrs, so root must be on build filesystem, not tmpfs
+    gchar *path = g_strdup(APPINSTALLD_TEST_TMPDIR "/appinstalld-XXXXXX");
+    g_mkdir_with_parents(APPINSTALLD_TEST_TMPDIR, 0755);
+    if (!g_mkdtemp(path)) {
+        errorText = std::string("unable to create root under ") + APPINSTALLD_TEST_TMPDIR;
+        g_free(path);
+        return false;
+    }
+    m_path = path;
+    g_free(path);
+
+    m_confPath = m_path + "/appinstalld-conf.json";
+    m_toolLogPath = m_path + "/tools.log";
+
+    setenv("APPINSTALLD_CONF_PATH", m_confPath.c_str(), 1);
+    setenv("APPINSTALLD_SCHEMA_PATH", APPINSTALLD_SOURCE_DIR "/files/schema", 1);
+    setenv("APPINSTALLD_FAKE_LOG", m_toolLogPath.c_str(), 1);
+    setenv("APPINSTALLD_FAKE_INSTALL_PATH", getInstallPath().c_str(), 1);
+
+    // commands run without absolute path (mount, ar, tar) are searched fakes first
+    const char *path_env = getenv("PATH");
+    std::string searchPath = std::string(APPINSTALLD_FAKE_DIR) + ":" + (path_env ? path_env : "/usr/bin:/bin");
+    setenv("PATH", searchPath.c_str(), 1);
+
+    if (!reconfigure(overrides, errorText))
+        return false;
+
+    std::vector<std::string> dirs = {
+        Settings::instance().getInstallerDataPath(),
+        Settings::instance().getInstallApplicationPath(true),
+        Settings::instance().getInstallPackagePath(true),
+        Settings::instance().getInstallServicePath(true),
+        Settings::instance().getSmackRulesDir(),
+    };
+
+    for (bool verified : { true, false }) {
+        dirs.push_back(Settings::instance().getLunaFilesPath(verified) + "/roles");
+        dirs.push_back(Settings::instance().getLunaFilesPath(verified) + "/services");
+        dirs.push_back(Settings::instance().getLunaUnifiedRolesDir(verified));
+        dirs.push_back(Settings::instance().getLunaUnifiedServicesDir(verified));
+        dirs.push_back(Settings::instance().getLunaUnifiedAPIPermissionsDir(verified));
+        dirs.push_back(Settings::instance().getLunaUnifiedGroupsDir(verified));
+        for (bool full : { true, false }) {
+            dirs.push_back(Settings::instance().getLunaUnifiedPermissionsDir(verified, full));
+            dirs.push_back(Settings::instance().getLunaUnifiedManifestsDir(verified, full));
+        }
+    }
+
+    for (const auto &dir : dirs) {
+        if (!Utils::make_dir(dir)) {
+            errorText = "unable to create " + dir;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TestRoot::reconfigure(pbnjson::JValue overrides, std::string &errorText)
+{
+    if (!writeConf(overrides, errorText))
+        return false;
+
+    if (!Settings::instance().loadConfigure()) {
+        errorText = "unable to load " + m_confPath;
+        return false;
+    }
+
+    return true;
+}
+
+void TestRoot::tearDown()
+{
+    if (m_path.empty())
+        return;
+
+    Utils::remove_dir(m_path);
+    m_path.clear();
+}
+
+const std::string& TestRoot::getPath() const
+{
+    return m_path;
+}
+
+std::string TestRoot::getInstallPath() const
+{
+    return m_path + "/internal";
+}
+
+std::vector<std::string> TestRoot::getToolLog() const
+{
+    std::vector<std::string> lines;
+    std::ifstream file(m_toolLogPath);
+    std::string line;
+
+    while (std::getline(file, line))
+        lines.push_back(line);
+
+    return lines;
+}
+
+void TestRoot::clearToolLog()
+{
+    Utils::remove_file(m_toolLogPath);
+}
+
+bool TestRoot::writeConf(pbnjson::JValue overrides, std::string &errorText)
+{
+    // steps and tunables are taken from shipped conf
+    JUtil::Error error;
+    pbnjson::JValue conf = JUtil::parseFileTrusted(APPINSTALLD_SOURCE_DIR "/files/conf/appinstalld-conf.json.in", &error);
+    if (!conf.isObject()) {
+        errorText = "unable to parse shipped conf: " + error.detail();
+        return false;
+    }
+
+    conf.put("installerDataPath", m_path + "/data");
+    conf.put("userinstallPath", getInstallPath());
+    conf.put("installerUtilityPath", APPINSTALLD_FAKE_DIR "/ApplicationInstallerUtility");
+    conf.put("cpusharesPath", "");
+    conf.put("jailerPath", APPINSTALLD_FAKE_DIR "/jailer");
+    conf.put("smackctlPath", APPINSTALLD_FAKE_DIR "/smackctl");
+    conf.put("smackRulesGenPath", APPINSTALLD_FAKE_DIR "/smack_rules_gen");
+    conf.put("smackRulesDir", m_path + "/smack/accesses.d/");
+    conf.put("smackXattrPrefix", "user.");
+    conf.put("sysbusRootPath", m_path + "/sysbus");
+    conf.put("lunaCallTimeout", 5000);
+
+    if (overrides.isObject()) {
+        for (pbnjson::JValue::KeyValue item : overrides.children())
+            conf.put(item.first.asString(), item.second);
+    }
+
+    std::ofstream file(m_confPath, std::ios::trunc);
+    file << JUtil::toSimpleString(conf);
+    file.close();
+
+    if (file.fail()) {
+        errorText = "unable to write " + m_confPath;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef TESTROOT_H
+#define TESTROOT_H
+
+#include <pbnjson.hpp>
+#include <string>
+#include <vector>
+
+/*! TestRoot class makes appinstalld run against temporary directory.
+ * It writes conf which points install, data, smack and luna-service2 paths under the root
+ * and helper binaries to fakes of tests/fake, then loads it to Settings.
+ * It must be set up before anything touches Settings, because conf path is read from
+ * environment when Settings is created.
+ */
+class TestRoot {
+public:
+    //! Constructor
+    TestRoot();
+
+    //! Destructor, root directory is removed
+    ~TestRoot();
+
+    //! Create root directory and load conf, overrides are merged into conf
+    bool setUp(std::string &errorText, pbnjson::JValue overrides = pbnjson::Object());
+
+    //! Rewrite conf with overrides and reload it to Settings
+    bool reconfigure(pbnjson::JValue overrides, std::string &errorText);
+
+    //! Remove root directory
+    void tearDown();
+
+    //! Get root directory
+    const std::string& getPath() const;
+
+    //! Get install base path of verified apps
+    std::string getInstallPath() const;
+
+    //! Get invocations of fake binaries, one line of "<name> <args...>" per invocation
+    std::vector<std::string> getToolLog() const;
+
+    //! Clear invocations of fake binaries
+    void clearToolLog();
+
+protected:
+    //! write conf of given overrides
+    bool writeConf(pbnjson::JValue overrides, std::string &errorText);
+
+private:
+    std::string m_path;
+    std::string m_confPath;
+    std::string m_toolLogPath;
+};
+
+#endif
@@ -0,0 +1,51 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+
+#include "base/Utils.h"
+#include "installer/AppPackage.h"
+#include "IpkBuilder.h"
+#include "TestEnv.h"
+
+/*! control of ipk of growing size
+ * Only ar headers and control member are read, so time should stay flat while size grows.
+ */
+static void BM_AppPackageReadControl(benchmark::State &state)
+{
+    const std::string appId = "com.example.control";
+    const std::string ipkPath = testRoot().getPath() + "/" + appId + "_" + std::to_string(state.range(0)) + ".ipk";
+
+    std::string errorText;
+    if (!IpkBuilder(appId).setPayload(1, state.range(0)).write(ipkPath, errorText)) {
+        state.SkipWithError(errorText.c_str());
+        return;
+    }
+
+    AppPackage appPackage;
+    for (auto _ : state) {
+        AppPackage::Control control;
+        if (!appPackage.readControl(ipkPath, control)) {
+            state.SkipWithError("failed to read control");
+            break;
+        }
+        benchmark::DoNotOptimize(control);
+    }
+
+    state.counters["ipkSize"] = state.range(0);
+    Utils::remove_file(ipkPath);
+}
+BENCHMARK(BM_AppPackageReadControl)->RangeMultiplier(16)->Range(4 << 10, 64 << 20)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,137 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#include <pbnjson.hpp>
+
+#include "base/JUtil.h"
+
+//! services.json of given number of services, like the one of a package with many services
+static pbnjson::JValue makeServicesJson(int64_t count)
+{
+    pbnjson::JValue services = pbnjson::Array();
+    for (int64_t i = 0; i < count; ++i) {
+        pbnjson::JValue command = pbnjson::Object();
+        command.put("name", "command" + std::to_string(i));
+        command.put("description", "generated command");
+        command.put("public", true);
+
+        pbnjson::JValue service = pbnjson::Object();
+        service.put("name", "com.example.app.service" + std::to_string(i));
+        service.put("description", "generated service");
+        service.put("Commands", pbnjson::Array() << command);
+        services.append(service);
+    }
+
+    pbnjson::JValue json = pbnjson::Object();
+    json.put("id", "com.example.app.service");
+    json.put("description", "generated service");
+    json.put("engine", "node");
+    json.put("executable", "service.js");
+    json.put("services", services);
+    return json;
+}
+
+//! request of install API, it's validated against its schema
+static void BM_JUtilParseRequest(benchmark::State &state)
+{
+    const std::string payload = "{\"id\":\"com.example.app\",\"ipkUrl\":\"/tmp/com.example.app_1.0.0_all.ipk\",\"subscribe\":true}";
+
+    for (auto _ : state) {
+        pbnjson::JValue json = JUtil::parse(payload.c_str(), "appInstallService.install");
+        benchmark::DoNotOptimize(json);
+    }
+}
+BENCHMARK(BM_JUtilParseRequest);
+
+//! services.json of growing size, it's validated against servicesJson-old schema
+static void BM_JUtilParseServicesJson(benchmark::State &state)
+{
+    const std::string payload = JUtil::toSimpleString(makeServicesJson(state.range(0)));
+
+    for (auto _ : state) {
+        pbnjson::JValue json = JUtil::parse(payload.c_str(), "servicesJson-old");
+        benchmark::DoNotOptimize(json);
+    }
+
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_JUtilParseServicesJson)->RangeMultiplier(4)->Range(1, 256);
+
+//! services.json through empty schema, as trusted data was parsed before parseTrusted
+static void BM_JUtilParseEmptySchema(benchmark::State &state)
+{
+    const std::string payload = JUtil::toSimpleString(makeServicesJson(state.range(0)));
+
+    for (auto _ : state) {
+        pbnjson::JValue json = JUtil::parse(payload.c_str(), "");
+        benchmark::DoNotOptimize(json);
+    }
+
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_JUtilParseEmptySchema)->RangeMultiplier(4)->Range(1, 256);
+
+//! services.json without validation, same documents as BM_JUtilParseEmptySchema
+static void BM_JUtilParseTrusted(benchmark::State &state)
+{
+    const std::string payload = JUtil::toSimpleString(makeServicesJson(state.range(0)));
+
+    for (auto _ : state) {
+        pbnjson::JValue json = JUtil::parseTrusted(payload.c_str());
+        benchmark::DoNotOptimize(json);
+    }
+
+    state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_JUtilParseTrusted)->RangeMultiplier(4)->Range(1, 256);
+
+//! status payload of one task, it's serialized on each status change
+static void BM_JUtilToSimpleStringStatus(benchmark::State &state)
+{
+    pbnjson::JValue details = pbnjson::Object();
+    details.put("client", "com.webos.appInstallService");
+    details.put("packageId", "com.example.app");
+    details.put("verified", true);
+    details.put("installBasePath", "/media/cryptofs");
+    details.put("state", "installing");
+
+    pbnjson::JValue status = pbnjson::Object();
+    status.put("id", "com.example.app");
+    status.put("statusValue", 14);
+    status.put("details", details);
+
+    for (auto _ : state) {
+        std::string payload = JUtil::toSimpleString(status);
+        benchmark::DoNotOptimize(payload);
+    }
+}
+BENCHMARK(BM_JUtilToSimpleStringStatus);
+
+//! services.json of growing size, same documents as parse case
+static void BM_JUtilToSimpleStringServicesJson(benchmark::State &state)
+{
+    pbnjson::JValue json = makeServicesJson(state.range(0));
+    size_t size = JUtil::toSimpleString(json).size();
+
+    for (auto _ : state) {
+        std::string payload = JUtil::toSimpleString(json);
+        benchmark::DoNotOptimize(payload);
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_JUtilToSimpleStringServicesJson)->RangeMultiplier(4)->Range(1, 256);
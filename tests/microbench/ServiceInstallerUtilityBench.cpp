@@ -0,0 +1,68 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+
+#include "installer/AppInfo.h"
+#include "installer/PackageInfo.h"
+#include "installer/ServiceInstallerUtility.h"
+#include "IpkBuilder.h"
+#include "settings/Settings.h"
+#include "TestEnv.h"
+
+//! test seam, it's friend of ServiceInstallerUtility
+class ServiceInstallerUtilityTest {
+public:
+    static bool generateManifestFile(const ServiceInstallerUtility::PathInfo &pathInfo, const std::string &installBasePath,
+                                     PackageInfo &packageInfo, const AppInfo &appInfo)
+    {
+        return ServiceInstallerUtility::generateManifestFile(pathInfo, installBasePath, packageInfo, appInfo);
+    }
+};
+
+//! manifest of package with given number of services, services.json of each is read and validated
+static void BM_GenerateManifestFile(benchmark::State &state)
+{
+    const std::string appId = "com.example.manifest" + std::to_string(state.range(0));
+    const std::string installBasePath = Settings::instance().getInstallPath(true);
+
+    std::string errorText;
+    if (!IpkBuilder(appId).setServiceCount(state.range(0)).unpack(installBasePath + "/apps", errorText)) {
+        state.SkipWithError(errorText.c_str());
+        return;
+    }
+
+    ServiceInstallerUtility::PathInfo pathInfo;
+    pathInfo.verified = true;
+    pathInfo.roled = Settings::instance().getLunaUnifiedRolesDir(true);
+    pathInfo.serviced = Settings::instance().getLunaUnifiedServicesDir(true);
+    pathInfo.permissiond = Settings::instance().getLunaUnifiedPermissionsDir(true, true);
+    pathInfo.api_permissiond = Settings::instance().getLunaUnifiedAPIPermissionsDir(true);
+    pathInfo.groupd = Settings::instance().getLunaUnifiedGroupsDir(true);
+    pathInfo.manifestsd = Settings::instance().getLunaUnifiedManifestsDir(true, true);
+
+    PackageInfo packageInfo(Settings::instance().getInstallPackagePath(true) + "/" + appId);
+    AppInfo appInfo(Settings::instance().getInstallApplicationPath(true) + "/" + appId);
+
+    for (auto _ : state) {
+        if (!ServiceInstallerUtilityTest::generateManifestFile(pathInfo, installBasePath, packageInfo, appInfo)) {
+            state.SkipWithError("failed to generate manifest file");
+            break;
+        }
+    }
+}
+BENCHMARK(BM_GenerateManifestFile)->Arg(0)->Arg(1)->Arg(4)->Arg(16);
@@ -0,0 +1,52 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#include <pbnjson.hpp>
+
+#include "installer/InstallHistory.h"
+#include "installer/Task.h"
+
+//! install task in opkg phase, made same way as AppInstaller::install does
+static void BM_TaskToJValue(benchmark::State &state)
+{
+    pbnjson::JValue details = pbnjson::Object();
+    details.put("client", "com.webos.appInstallService");
+    details.put("subscribe", true);
+
+    pbnjson::JValue appInfo = pbnjson::Object();
+    appInfo.put("id", "com.example.app");
+    appInfo.put("details", details);
+
+    pbnjson::JValue param = pbnjson::Object();
+    param.put("id", "com.example.app");
+    param.put("name", "InstallTask");
+    param.put("ipkurl", "/tmp/com.example.app_1.0.0_all.ipk");
+    param.put("appinfo", appInfo);
+    param.put("verify", true);
+
+    Task task;
+    task.initialize(param);
+    task.setPackageId("com.example.app");
+    task.setInstallBasePath("/media/cryptofs");
+    task.setStep(IpkInstallCurrent);
+
+    for (auto _ : state) {
+        pbnjson::JValue json = task.toJValue();
+        benchmark::DoNotOptimize(json);
+    }
+}
+BENCHMARK(BM_TaskToJValue);
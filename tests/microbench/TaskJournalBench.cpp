@@ -0,0 +1,154 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#include <pbnjson.hpp>
+#include <vector>
+
+#include "installer/InstallHistory.h"
+#include "installer/TaskJournal.h"
+#include "TestEnv.h"
+
+#define BUFFERED_RECORDS    1024
+
+//! completed steps of default install graph, each of them is journaled with a checkpoint
+static const std::vector<TaskStep> INSTALL_STEPS = {
+    IpkParseComplete,
+    GetIpkInfoComplete,
+    AppCloseComplete,
+    IpkInstallComplete,
+    ServiceInstallComplete,
+    InstallSmackComplete,
+    InstallComplete
+};
+
+static pbnjson::JValue makeParam(const std::string &appId)
+{
+    pbnjson::JValue details = pbnjson::Object();
+    details.put("client", "com.webos.appInstallService");
+
+    pbnjson::JValue appInfo = pbnjson::Object();
+    appInfo.put("id", appId);
+    appInfo.put("details", details);
+
+    pbnjson::JValue param = pbnjson::Object();
+    param.put("id", appId);
+    param.put("name", "InstallTask");
+    param.put("ipkurl", "/tmp/" + appId + "_1.0.0_all.ipk");
+    param.put("appinfo", appInfo);
+    param.put("verify", true);
+    return param;
+}
+
+//! same fields as Task::getCheckpoint
+static pbnjson::JValue makeCheckpoint(const std::string &appId, TaskStep step)
+{
+    pbnjson::JValue checkpoint = pbnjson::Object();
+    checkpoint.put("step", (int) step);
+    checkpoint.put("packageId", appId);
+    checkpoint.put("packageVersion", "1.0.0");
+    checkpoint.put("installBasePath", "/media/cryptofs");
+    checkpoint.put("unpackFileSize", (int64_t) 1024 * 1024);
+    checkpoint.put("allowReInstall", false);
+    checkpoint.put("services", pbnjson::Array());
+    return checkpoint;
+}
+
+static bool openJournal(benchmark::State &state)
+{
+    std::vector<TaskJournal::Record> unfinished;
+    if (!TaskJournal::instance().open(testRoot().getPath() + "/data/taskjournal.bench", unfinished)) {
+        state.SkipWithError("failed to open task journal");
+        return false;
+    }
+
+    return true;
+}
+
+/*! step and checkpoint records of one step transition
+ * They're only buffered, write and sync are deferred to main loop which doesn't run here,
+ * so buffer is synced out of timing every BUFFERED_RECORDS iterations.
+ */
+static void BM_TaskJournalStep(benchmark::State &state)
+{
+    const std::string appId = "com.example.journal";
+    if (!openJournal(state))
+        return;
+
+    pbnjson::JValue checkpoint = makeCheckpoint(appId, IpkInstallComplete);
+    TaskJournal::instance().begin(appId, makeParam(appId));
+
+    int64_t count = 0;
+    for (auto _ : state) {
+        TaskJournal::instance().step(appId, IpkInstallComplete);
+        TaskJournal::instance().checkpoint(appId, checkpoint);
+
+        if (++count % BUFFERED_RECORDS == 0) {
+            state.PauseTiming();
+            TaskJournal::instance().end(appId);
+            TaskJournal::instance().begin(appId, makeParam(appId));
+            state.ResumeTiming();
+        }
+    }
+
+    TaskJournal::instance().end(appId);
+    TaskJournal::instance().close();
+}
+BENCHMARK(BM_TaskJournalStep);
+
+//! begin and end records, each of them is written and synced to storage at once
+static void BM_TaskJournalBeginEnd(benchmark::State &state)
+{
+    const std::string appId = "com.example.journal";
+    if (!openJournal(state))
+        return;
+
+    pbnjson::JValue param = makeParam(appId);
+    for (auto _ : state) {
+        TaskJournal::instance().begin(appId, param);
+        TaskJournal::instance().end(appId);
+    }
+
+    state.counters["syncs"] = benchmark::Counter(2, benchmark::Counter::kIsIterationInvariantRate);
+    TaskJournal::instance().close();
+}
+BENCHMARK(BM_TaskJournalBeginEnd)->Unit(benchmark::kMicrosecond);
+
+//! all records journaled for one install task of default step graph
+static void BM_TaskJournalInstallTask(benchmark::State &state)
+{
+    const std::string appId = "com.example.journal";
+    if (!openJournal(state))
+        return;
+
+    pbnjson::JValue param = makeParam(appId);
+    std::vector<pbnjson::JValue> checkpoints;
+    for (TaskStep step : INSTALL_STEPS)
+        checkpoints.push_back(makeCheckpoint(appId, step));
+
+    for (auto _ : state) {
+        TaskJournal::instance().begin(appId, param);
+        for (size_t i = 0; i < INSTALL_STEPS.size(); ++i) {
+            TaskJournal::instance().step(appId, INSTALL_STEPS[i]);
+            TaskJournal::instance().checkpoint(appId, checkpoints[i]);
+        }
+        TaskJournal::instance().end(appId);
+    }
+
+    state.counters["records"] = benchmark::Counter(INSTALL_STEPS.size() * 2 + 2, benchmark::Counter::kIsIterationInvariantRate);
+    TaskJournal::instance().close();
+}
+BENCHMARK(BM_TaskJournalInstallTask)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,424 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <algorithm>
+#include <glib.h>
+#include <gtest/gtest.h>
+#include <pbnjson.hpp>
+#include <stdlib.h>
+
+#include "base/JUtil.h"
+#include "base/Utils.h"
+#include "installer/AppInstaller.h"
+#include "installer/AppInstallerErrors.h"
+#include "installer/InstallHistory.h"
+#include "installer/TaskJournal.h"
+#include "IpkBuilder.h"
+#include "settings/Settings.h"
+#include "TaskRunner.h"
+#include "TestEnv.h"
+
+#define TASK_TIMEOUT    (30 * 1000)
+
+class AppInstallerTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        testRoot().clearToolLog();
+        fakeBus().clear();
+    }
+
+    void TearDown() override
+    {
+        unsetenv("APPINSTALLD_FAKE_INSTALL_DELAY");
+
+        std::string errorText;
+        EXPECT_TRUE(testRoot().reconfigure(pbnjson::Object(), errorText)) << errorText;
+    }
+
+    //! change conf for this test, it's restored in TearDown
+    static ::testing::AssertionResult configure(pbnjson::JValue overrides)
+    {
+        std::string errorText;
+        if (!testRoot().reconfigure(overrides, errorText))
+            return ::testing::AssertionFailure() << errorText;
+        return ::testing::AssertionSuccess();
+    }
+
+    //! write generated ipk of appId and get its path
+    static std::string writeIpk(const std::string &appId)
+    {
+        std::string ipkPath = testRoot().getPath() + "/" + appId + ".ipk";
+        std::string errorText;
+        EXPECT_TRUE(IpkBuilder(appId).write(ipkPath, errorText)) << errorText;
+        return ipkPath;
+    }
+
+    //! request install of generated ipk
+    static bool requestInstall(const std::string &appId)
+    {
+        int errorCode = 0;
+        std::string errorText;
+        bool result = (AppInstaller::instance().install(appId, writeIpk(appId), makeAppInfo(appId), errorCode, errorText) != nullptr);
+        EXPECT_TRUE(result) << errorCode << " " << errorText;
+        return result;
+    }
+
+    //! appInfo made by AppInstallService for request
+    static pbnjson::JValue makeAppInfo(const std::string &appId)
+    {
+        pbnjson::JValue details = pbnjson::Object();
+        details.put("client", "com.example.test");
+
+        pbnjson::JValue appInfo = pbnjson::Object();
+        appInfo.put("id", appId);
+        appInfo.put("details", details);
+        return appInfo;
+    }
+
+    //! check files of appId are unpacked
+    static bool isInstalled(const std::string &appId)
+    {
+        std::string appPath = Settings::instance().getInstallApplicationPath(true) + "/" + appId;
+        return g_file_test((appPath + "/appinfo.json").c_str(), G_FILE_TEST_EXISTS);
+    }
+
+    //! number of fake opkg runs which installed something
+    static size_t countInstallRuns()
+    {
+        std::vector<std::string> log = testRoot().getToolLog();
+        return std::count_if(log.begin(), log.end(), [] (const std::string &line) {
+            return line.compare(0, 38, "ApplicationInstallerUtility -c install") == 0;
+        });
+    }
+
+    //! get last payload replied to subscribers of key
+    static pbnjson::JValue getLastReply(const std::string &key)
+    {
+        std::vector<std::string> replies = fakeBus().getReplies(key);
+        if (replies.empty())
+            return pbnjson::JValue();
+
+        return JUtil::parseTrusted(replies.back().c_str());
+    }
+};
+
+TEST_F(AppInstallerTest, CancelQueuedTask)
+{
+    const std::string runningId = "com.example.cancel.running";
+    const std::string queuedId = "com.example.cancel.queued";
+    pbnjson::JValue conf = pbnjson::Object();
+    conf.put("maxConcurrentTasks", 1);
+    ASSERT_TRUE(configure(conf));
+
+    TaskRunner runner;
+    runner.expect(runningId);
+    runner.expect(queuedId);
+    ASSERT_TRUE(requestInstall(runningId));
+    ASSERT_TRUE(requestInstall(queuedId));
+
+    // it's finished at once, it has never run
+    int errorCode = 0;
+    std::string errorText;
+    EXPECT_TRUE(AppInstaller::instance().cancel(queuedId, errorCode, errorText)) << errorText;
+    ASSERT_NE(nullptr, runner.getResult(queuedId));
+    EXPECT_EQ(APP_INSTALL_ERR_CANCELED, runner.getResult(queuedId)->errorCode);
+
+    ASSERT_TRUE(runner.wait(TASK_TIMEOUT));
+    ASSERT_NE(nullptr, runner.getResult(runningId));
+    EXPECT_EQ(0, runner.getResult(runningId)->errorCode) << runner.getResult(runningId)->errorText;
+    EXPECT_TRUE(isInstalled(runningId));
+    EXPECT_FALSE(isInstalled(queuedId));
+    EXPECT_EQ(1u, countInstallRuns());
+}
+
+TEST_F(AppInstallerTest, CancelTaskInOpkg)
+{
+    const std::string canceledId = "com.example.cancel.opkg";
+    const std::string nextId = "com.example.cancel.next";
+    pbnjson::JValue conf = pbnjson::Object();
+    conf.put("maxConcurrentTasks", 1);
+    ASSERT_TRUE(configure(conf));
+    // opkg is busy long enough to be canceled in it
+    setenv("APPINSTALLD_FAKE_INSTALL_DELAY", "2", 1);
+
+    TaskRunner runner;
+    runner.expect(canceledId);
+    ASSERT_TRUE(requestInstall(canceledId));
+
+    std::shared_ptr<Task> task = AppInstaller::instance().get(canceledId);
+    ASSERT_NE(nullptr, task);
+    bool requested = false;
+    boost::signals2::scoped_connection connection = task->signalStatusChanged.connect([canceledId, &requested] (const Task &current) {
+        if (requested || current.getStep() != IpkInstallStarting)
+            return;
+
+        // task isn't canceled from its own signal
+        requested = true;
+        Utils::async([canceledId] {
+            int errorCode = 0;
+            std::string errorText;
+            EXPECT_TRUE(AppInstaller::instance().cancel(canceledId, errorCode, errorText)) << errorText;
+        });
+    });
+    task.reset();
+
+    // next one waits for running slot of canceled one
+    ASSERT_TRUE(requestInstall(nextId));
+    ASSERT_TRUE(runner.wait(TASK_TIMEOUT));
+    connection.disconnect();
+
+    ASSERT_TRUE(requested);
+    ASSERT_NE(nullptr, runner.getResult(canceledId));
+    EXPECT_EQ(APP_INSTALL_ERR_CANCELED, runner.getResult(canceledId)->errorCode);
+    EXPECT_EQ(nullptr, runner.getResult(nextId));
+
+    unsetenv("APPINSTALLD_FAKE_INSTALL_DELAY");
+    runner.expect(nextId);
+    ASSERT_TRUE(runner.wait(TASK_TIMEOUT));
+    ASSERT_NE(nullptr, runner.getResult(nextId));
+    EXPECT_EQ(0, runner.getResult(nextId)->errorCode) << runner.getResult(nextId)->errorText;
+    EXPECT_TRUE(isInstalled(nextId));
+
+    // canceled install had started opkg, so its files are cleaned up by remove task
+    auto isRemoved = [&runner, &canceledId] {
+        const std::vector<TaskRunner::Result> &results = runner.getResults();
+        return std::any_of(results.begin(), results.end(), [&canceledId] (const TaskRunner::Result &result) {
+            return result.appId == canceledId && result.name == "RemoveTask";
+        });
+    };
+    if (!isRemoved()) {
+        runner.expect(canceledId);
+        ASSERT_TRUE(runner.wait(TASK_TIMEOUT));
+    }
+    EXPECT_TRUE(isRemoved());
+}
+
+TEST_F(AppInstallerTest, CancelUnknownTask)
+{
+    int errorCode = 0;
+    std::string errorText;
+    EXPECT_FALSE(AppInstaller::instance().cancel("com.example.cancel.unknown", errorCode, errorText));
+    EXPECT_EQ(APP_INSTALL_ERR_GENERAL, errorCode);
+}
+
+TEST_F(AppInstallerTest, InstallBatch)
+{
+    const std::vector<std::string> appIds = {
+        "com.example.batch0",
+        "com.example.batch1",
+        "com.example.batch2"
+    };
+
+    TaskRunner runner;
+    pbnjson::JValue packages = pbnjson::Array();
+    for (const auto &appId : appIds) {
+        pbnjson::JValue package = pbnjson::Object();
+        package.put("id", appId);
+        package.put("ipkUrl", writeIpk(appId));
+        packages.append(package);
+        runner.expect(appId);
+    }
+
+    int errorCode = 0;
+    std::string errorText;
+    std::string batchId = AppInstaller::instance().installBatch(packages, "com.example.test", errorCode, errorText);
+    ASSERT_FALSE(batchId.empty()) << errorCode << " " << errorText;
+    ASSERT_TRUE(runner.wait(TASK_TIMEOUT));
+
+    for (const auto &appId : appIds) {
+        ASSERT_NE(nullptr, runner.getResult(appId));
+        EXPECT_EQ(0, runner.getResult(appId)->errorCode) << runner.getResult(appId)->errorText;
+        EXPECT_TRUE(isInstalled(appId));
+    }
+
+    pbnjson::JValue batch = getLastReply("batch_" + batchId);
+    ASSERT_TRUE(batch.isObject());
+    EXPECT_EQ(batchId, batch["batchId"].asString());
+    EXPECT_EQ(3, batch["total"].asNumber<int>());
+    EXPECT_EQ(3, batch["completed"].asNumber<int>());
+    EXPECT_EQ(0, batch["failed"].asNumber<int>());
+    ASSERT_EQ(3, batch["packages"].arraySize());
+    for (int i = 0; i < batch["packages"].arraySize(); ++i) {
+        EXPECT_EQ(appIds[i], batch["packages"][i]["id"].asString());
+        EXPECT_EQ("installed", batch["packages"][i]["details"]["state"].asString());
+    }
+}
+
+TEST_F(AppInstallerTest, InstallBatchRejectsDuplicatedApp)
+{
+    const std::string appId = "com.example.batch.duplicated";
+    std::string ipkPath = writeIpk(appId);
+
+    pbnjson::JValue packages = pbnjson::Array();
+    for (int i = 0; i < 2; ++i) {
+        pbnjson::JValue package = pbnjson::Object();
+        package.put("id", appId);
+        package.put("ipkUrl", ipkPath);
+        packages.append(package);
+    }
+
+    // nothing is installed when any of packages is invalid
+    int errorCode = 0;
+    std::string errorText;
+    EXPECT_TRUE(AppInstaller::instance().installBatch(packages, "com.example.test", errorCode, errorText).empty());
+    EXPECT_EQ(APP_INSTALL_ERR_DUPLICATED, errorCode);
+    EXPECT_EQ(nullptr, AppInstaller::instance().get(appId));
+}
+
+TEST_F(AppInstallerTest, OpkgBatchInstall)
+{
+    const std::vector<std::string> appIds = {
+        "com.example.opkgbatch0",
+        "com.example.opkgbatch1",
+        "com.example.opkgbatch2"
+    };
+    pbnjson::JValue conf = pbnjson::Object();
+    conf.put("opkgBatchInstall", true);
+    conf.put("maxConcurrentTasks", 4);
+    ASSERT_TRUE(configure(conf));
+    // first run is busy while the others arrive, so they're installed by next run
+    setenv("APPINSTALLD_FAKE_INSTALL_DELAY", "1", 1);
+
+    TaskRunner runner;
+    for (const auto &appId : appIds) {
+        runner.expect(appId);
+        ASSERT_TRUE(requestInstall(appId));
+    }
+    ASSERT_TRUE(runner.wait(TASK_TIMEOUT));
+
+    for (const auto &appId : appIds) {
+        const TaskRunner::Result *result = runner.getResult(appId);
+        ASSERT_NE(nullptr, result);
+        EXPECT_EQ(0, result->errorCode) << result->errorText;
+        EXPECT_TRUE(isInstalled(appId));
+
+        // progress lines of shared run are delivered to each package
+        auto it = std::find_if(result->stepTimes.begin(), result->stepTimes.end(),
+                               [] (const std::pair<TaskStep, int64_t> &v) { return v.first == IpkInstallComplete; });
+        EXPECT_NE(result->stepTimes.end(), it) << appId;
+    }
+
+    EXPECT_LT(countInstallRuns(), appIds.size());
+}
+
+TEST_F(AppInstallerTest, StatusIsCoalesced)
+{
+    const std::string appId = "com.example.coalesce";
+    // whole install fits in one interval, so only few statuses go out
+    pbnjson::JValue conf = pbnjson::Object();
+    conf.put("statusInterval", 5000);
+    ASSERT_TRUE(configure(conf));
+
+    TaskRunner runner;
+    runner.expect(appId);
+    ASSERT_TRUE(requestInstall(appId));
+    ASSERT_TRUE(runner.wait(TASK_TIMEOUT));
+
+    const TaskRunner::Result *result = runner.getResult(appId);
+    ASSERT_NE(nullptr, result);
+    ASSERT_EQ(0, result->errorCode) << result->errorText;
+
+    std::vector<std::string> replies = fakeBus().getReplies("status_" + appId);
+    ASSERT_FALSE(replies.empty());
+    EXPECT_LT(replies.size(), result->stepTimes.size());
+
+    // terminal status is flushed when task is finished
+    pbnjson::JValue status = JUtil::parseTrusted(replies.back().c_str());
+    EXPECT_EQ((int) InstallComplete, status["statusValue"].asNumber<int>());
+    EXPECT_EQ("installed", status["details"]["state"].asString());
+}
+
+TEST_F(AppInstallerTest, JournalKeepsRecordsUntilJournaledAgain)
+{
+    const std::string appId = "com.example.journal.keep";
+    std::string path = testRoot().getPath() + "/keep-taskjournal";
+    std::vector<TaskJournal::Record> unfinished;
+
+    AppInstaller::instance().finalize();
+
+    pbnjson::JValue param = pbnjson::Object();
+    param.put("id", appId);
+    param.put("name", "InstallTask");
+    ASSERT_TRUE(TaskJournal::instance().open(path, unfinished));
+    EXPECT_TRUE(unfinished.empty());
+    TaskJournal::instance().begin(appId, param);
+    TaskJournal::instance().step(appId, IpkInstallRequested, true);
+    TaskJournal::instance().step(appId, IpkInstallCurrent, true);
+    TaskJournal::instance().close();
+
+    // nothing is journaled by second run, record should survive it with its opkg state
+    for (int run = 0; run < 2; ++run) {
+        unfinished.clear();
+        ASSERT_TRUE(TaskJournal::instance().open(path, unfinished));
+        TaskJournal::instance().close();
+
+        ASSERT_EQ(1u, unfinished.size()) << "run " << run;
+        EXPECT_EQ(appId, unfinished[0].param["id"].asString());
+        EXPECT_EQ(IpkInstallCurrent, unfinished[0].lastStep);
+        EXPECT_TRUE(unfinished[0].opkgStarted);
+        EXPECT_FALSE(unfinished[0].opkgCompleted);
+    }
+
+    ASSERT_TRUE(AppInstaller::instance().initialize());
+}
+
+TEST_F(AppInstallerTest, JournalRecovery)
+{
+    const std::string restartedId = "com.example.journal.restarted";
+    const std::string completedId = "com.example.journal.completed";
+    const std::string failedId = "com.example.journal.failed";
+    std::string path = Settings::instance().getInstallerDataPath() + "/taskjournal";
+    std::vector<TaskJournal::Record> unfinished;
+
+    // journal of last run which is interrupted while tasks are running
+    AppInstaller::instance().finalize();
+    ASSERT_TRUE(TaskJournal::instance().open(path, unfinished));
+
+    auto begin = [] (const std::string &appId, TaskStep lastStep) {
+        pbnjson::JValue param = pbnjson::Object();
+        param.put("id", appId);
+        param.put("ipkurl", writeIpk(appId));
+        param.put("appinfo", makeAppInfo(appId));
+        param.put("verify", true);
+        param.put("downgrade", true);
+        param.put("name", "InstallTask");
+        TaskJournal::instance().begin(appId, param);
+        TaskJournal::instance().step(appId, lastStep, true);
+    };
+
+    // nothing is completed before opkg, so it's started over
+    begin(restartedId, IpkParseComplete);
+    // they're already told to client, they're not run again
+    begin(completedId, InstallComplete);
+    begin(failedId, ErrorInstall);
+    TaskJournal::instance().close();
+
+    TaskRunner runner;
+    runner.expect(restartedId);
+    ASSERT_TRUE(AppInstaller::instance().initialize());
+
+    EXPECT_EQ(nullptr, AppInstaller::instance().get(completedId));
+    EXPECT_EQ(nullptr, AppInstaller::instance().get(failedId));
+
+    ASSERT_TRUE(runner.wait(TASK_TIMEOUT));
+    ASSERT_NE(nullptr, runner.getResult(restartedId));
+    EXPECT_EQ(0, runner.getResult(restartedId)->errorCode) << runner.getResult(restartedId)->errorText;
+    EXPECT_TRUE(isInstalled(restartedId));
+    EXPECT_EQ(nullptr, runner.getResult(completedId));
+    EXPECT_EQ(nullptr, runner.getResult(failedId));
+}
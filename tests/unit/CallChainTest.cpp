@@ -0,0 +1,288 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <glib.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <pbnjson.hpp>
+
+#include "base/CallChain.h"
+#include "TestEnv.h"
+
+#define CHAIN_TIMEOUT   (10 * 1000)
+
+#define SLOW_URI        "luna://com.example.test/slow"
+
+namespace {
+
+//! item which finishes with given result after delay in ms, or when it's canceled if delay is negative
+class TestItem : public CallItem {
+public:
+    TestItem(bool result, int delay, std::string errorText = "")
+        : m_result(result),
+          m_delay(delay),
+          m_errorText(std::move(errorText)),
+          m_called(false),
+          m_canceled(false),
+          m_finished(false),
+          m_sourceId(0)
+    {
+    }
+
+    virtual ~TestItem()
+    {
+        if (m_sourceId != 0)
+            g_source_remove(m_sourceId);
+    }
+
+    virtual bool Call() override
+    {
+        m_called = true;
+        if (m_delay >= 0)
+            m_sourceId = g_timeout_add(m_delay, cbFinish, this);
+        return true;
+    }
+
+    virtual void cancel() override
+    {
+        m_canceled = true;
+
+        // delayed one finishes as scheduled
+        if (m_called && m_delay < 0 && !m_finished) {
+            m_finished = true;
+            onFinished(false, "Cancelled");
+        }
+    }
+
+    bool isCalled() const { return m_called; }
+    bool isCanceled() const { return m_canceled; }
+
+private:
+    static gboolean cbFinish(gpointer data)
+    {
+        TestItem *item = static_cast<TestItem*>(data);
+        item->m_sourceId = 0;
+        item->m_finished = true;
+        item->onFinished(item->m_result, item->m_errorText);
+        return G_SOURCE_REMOVE;
+    }
+
+    bool m_result;
+    int m_delay;
+    std::string m_errorText;
+    bool m_called;
+    bool m_canceled;
+    bool m_finished;
+    guint m_sourceId;
+};
+
+}
+
+class CallChainTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        fakeBus().clear();
+        m_loop = g_main_loop_new(NULL, FALSE);
+        m_finished = false;
+        m_result = pbnjson::JValue();
+    }
+
+    void TearDown() override
+    {
+        g_main_loop_unref(m_loop);
+    }
+
+    //! acquire chain whose result is kept by this test
+    CallChain& acquire()
+    {
+        return CallChain::acquire([this] (pbnjson::JValue result, void*) {
+            m_finished = true;
+            m_result = result;
+            g_main_loop_quit(m_loop);
+        });
+    }
+
+    //! run main loop until chain is finished, false if timeout in ms is expired
+    bool wait(unsigned int timeout = CHAIN_TIMEOUT)
+    {
+        if (m_finished)
+            return true;
+
+        guint timer = g_timeout_add(timeout, cbTimeout, m_loop);
+        g_main_loop_run(m_loop);
+        if (m_finished)
+            g_source_remove(timer);
+        return m_finished;
+    }
+
+    //! number of calls sent to uri
+    static size_t countCalls(const std::string &uri)
+    {
+        size_t count = 0;
+        for (const auto &call : fakeBus().getCalls()) {
+            if (call.uri == uri)
+                ++count;
+        }
+        return count;
+    }
+
+    static gboolean cbTimeout(gpointer data)
+    {
+        g_main_loop_quit(static_cast<GMainLoop*>(data));
+        return G_SOURCE_REMOVE;
+    }
+
+    GMainLoop *m_loop;
+    bool m_finished;
+    pbnjson::JValue m_result;
+};
+
+TEST_F(CallChainTest, ParallelJoinAllFailsIfAnyBranchFails)
+{
+    auto parallel = std::make_shared<ParallelCallItem>(ParallelCallItem::JOIN_ALL);
+    auto ok = std::make_shared<TestItem>(true, 10);
+    auto failed = std::make_shared<TestItem>(false, 20, "branch failed");
+    auto next = std::make_shared<TestItem>(true, 0);
+    parallel->addBranch().add(ok);
+    parallel->addBranch().add(failed);
+    EXPECT_EQ(2u, parallel->getBranchCount());
+
+    CallChain &chain = acquire();
+    chain.add(parallel).add(next);
+    chain.run();
+    ASSERT_TRUE(wait());
+
+    EXPECT_FALSE(m_result["returnValue"].asBool());
+    EXPECT_EQ("branch failed", m_result["errorText"].asString());
+    EXPECT_TRUE(ok->isCalled());
+    EXPECT_TRUE(failed->isCalled());
+    EXPECT_FALSE(next->isCalled());
+}
+
+TEST_F(CallChainTest, ParallelJoinAllWaitsForAllBranches)
+{
+    auto parallel = std::make_shared<ParallelCallItem>(ParallelCallItem::JOIN_ALL);
+    auto fast = std::make_shared<TestItem>(true, 0);
+    auto slow = std::make_shared<TestItem>(true, 50);
+    auto next = std::make_shared<TestItem>(true, 0);
+    parallel->addBranch().add(fast);
+    parallel->addBranch().add(slow);
+
+    CallChain &chain = acquire();
+    chain.add(parallel).add(next);
+    chain.run();
+    ASSERT_TRUE(wait());
+
+    EXPECT_TRUE(m_result["returnValue"].asBool());
+    EXPECT_TRUE(next->isCalled());
+}
+
+TEST_F(CallChainTest, ParallelJoinAnySucceedsByOneBranch)
+{
+    auto parallel = std::make_shared<ParallelCallItem>(ParallelCallItem::JOIN_ANY);
+    auto failed = std::make_shared<TestItem>(false, 0, "branch failed");
+    auto ok = std::make_shared<TestItem>(true, 10);
+    // it's left running, join doesn't wait for it
+    auto pending = std::make_shared<TestItem>(true, -1);
+    parallel->addBranch().add(failed);
+    parallel->addBranch().add(ok);
+    parallel->addBranch().add(pending);
+
+    CallChain &chain = acquire();
+    chain.add(parallel);
+    chain.run();
+    ASSERT_TRUE(wait());
+
+    EXPECT_TRUE(m_result["returnValue"].asBool());
+    EXPECT_TRUE(pending->isCalled());
+}
+
+TEST_F(CallChainTest, ParallelJoinAnyFailsIfAllBranchesFail)
+{
+    auto parallel = std::make_shared<ParallelCallItem>(ParallelCallItem::JOIN_ANY);
+    parallel->addBranch().add(std::make_shared<TestItem>(false, 0, "first failed"));
+    parallel->addBranch().add(std::make_shared<TestItem>(false, 10, "second failed"));
+
+    CallChain &chain = acquire();
+    chain.add(parallel);
+    chain.run();
+    ASSERT_TRUE(wait());
+
+    EXPECT_FALSE(m_result["returnValue"].asBool());
+    EXPECT_EQ("first failed; second failed", m_result["errorText"].asString());
+}
+
+TEST_F(CallChainTest, CancelReachesRunningBranches)
+{
+    auto parallel = std::make_shared<ParallelCallItem>(ParallelCallItem::JOIN_ALL);
+    auto first = std::make_shared<TestItem>(true, -1);
+    auto second = std::make_shared<TestItem>(true, -1);
+    auto next = std::make_shared<TestItem>(true, 0);
+    parallel->addBranch().add(first);
+    parallel->addBranch().add(second);
+
+    CallChain &chain = acquire();
+    chain.add(parallel).add(next);
+    chain.run();
+
+    // branches wait until they're canceled, so chain can't finish without it
+    EXPECT_FALSE(wait(50));
+    chain.cancel();
+    ASSERT_TRUE(wait());
+
+    EXPECT_FALSE(m_result["returnValue"].asBool());
+    EXPECT_EQ("Cancelled", m_result["errorText"].asString());
+    EXPECT_TRUE(first->isCanceled());
+    EXPECT_TRUE(second->isCanceled());
+    EXPECT_FALSE(next->isCalled());
+}
+
+TEST_F(CallChainTest, LSCallRetriesAfterTimeout)
+{
+    fakeBus().setDropCount(SLOW_URI, 2);
+
+    auto call = std::make_shared<LSCallItem>("com.webos.appInstallService", SLOW_URI, "{}");
+    call->setTimeout(50);
+    call->setRetry(2, 10);
+
+    CallChain &chain = acquire();
+    chain.add(call);
+    chain.run();
+    ASSERT_TRUE(wait());
+
+    EXPECT_TRUE(m_result["returnValue"].asBool()) << m_result["errorText"].asString();
+    EXPECT_EQ(3u, countCalls(SLOW_URI));
+}
+
+TEST_F(CallChainTest, LSCallFailsWhenRetriesAreUsedUp)
+{
+    fakeBus().setDropCount(SLOW_URI, 3);
+
+    auto call = std::make_shared<LSCallItem>("com.webos.appInstallService", SLOW_URI, "{}");
+    call->setTimeout(50);
+    call->setRetry(1, 10);
+
+    CallChain &chain = acquire();
+    chain.add(call);
+    chain.run();
+    ASSERT_TRUE(wait());
+
+    EXPECT_FALSE(m_result["returnValue"].asBool());
+    EXPECT_EQ(std::string(SLOW_URI) + " is timed out", m_result["errorText"].asString());
+    EXPECT_EQ(2u, countCalls(SLOW_URI));
+}
@@ -0,0 +1,251 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <glib.h>
+#include <gtest/gtest.h>
+#include <pbnjson.hpp>
+
+#include "base/JUtil.h"
+#include "installer/AppInstaller.h"
+#include "installer/InstallHistory.h"
+#include "IpkBuilder.h"
+#include "settings/Settings.h"
+#include "TaskRunner.h"
+#include "TestEnv.h"
+
+#define TASK_TIMEOUT    (30 * 1000)
+
+class InstallRemoveTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        testRoot().clearToolLog();
+        fakeBus().clear();
+    }
+
+    //! install generated ipk of appId and wait for it
+    void install(const std::string &appId, size_t serviceCount, TaskRunner &runner)
+    {
+        std::string ipkPath = testRoot().getPath() + "/" + appId + ".ipk";
+        std::string errorText;
+        ASSERT_TRUE(IpkBuilder(appId).setServiceCount(serviceCount).write(ipkPath, errorText)) << errorText;
+
+        int errorCode = 0;
+        ASSERT_TRUE(AppInstaller::instance().install(appId, ipkPath, makeAppInfo(appId), errorCode, errorText))
+            << errorCode << " " << errorText;
+
+        runner.expect(appId);
+        ASSERT_TRUE(runner.wait(TASK_TIMEOUT)) << "install of " << appId << " is not finished";
+    }
+
+    //! remove appId and wait for it
+    void remove(const std::string &appId, TaskRunner &runner)
+    {
+        pbnjson::JValue appInfo = pbnjson::Object();
+        appInfo.put("id", appId);
+        appInfo.put("removable", true);
+        appInfo.put("folderPath", Settings::instance().getInstallApplicationPath(true) + "/" + appId);
+        fakeBus().setAppInfo(appId, appInfo);
+
+        int errorCode = 0;
+        std::string errorText;
+        ASSERT_TRUE(AppInstaller::instance().remove(appId, makeAppInfo(appId), errorCode, errorText))
+            << errorCode << " " << errorText;
+
+        runner.expect(appId);
+        ASSERT_TRUE(runner.wait(TASK_TIMEOUT)) << "remove of " << appId << " is not finished";
+        fakeBus().removeAppInfo(appId);
+    }
+
+    //! appInfo made by AppInstallService for request
+    static pbnjson::JValue makeAppInfo(const std::string &appId)
+    {
+        pbnjson::JValue details = pbnjson::Object();
+        details.put("client", "com.example.test");
+
+        pbnjson::JValue appInfo = pbnjson::Object();
+        appInfo.put("id", appId);
+        appInfo.put("details", details);
+        return appInfo;
+    }
+
+    //! check expected steps are passed in order, other steps can be in between
+    static ::testing::AssertionResult passedInOrder(const Task::StepTimes &stepTimes, const std::vector<TaskStep> &expected)
+    {
+        auto it = stepTimes.begin();
+        for (TaskStep step : expected) {
+            it = std::find_if(it, stepTimes.end(),
+                              [step] (const std::pair<TaskStep, int64_t> &v) { return v.first == step; });
+            if (it == stepTimes.end())
+                return ::testing::AssertionFailure() << "step " << (int) step << " is not passed in order";
+        }
+
+        return ::testing::AssertionSuccess();
+    }
+
+    //! get last status replied to subscribers of appId
+    static pbnjson::JValue getLastStatus(const std::string &appId)
+    {
+        std::vector<std::string> replies = fakeBus().getReplies("status_" + appId);
+        if (replies.empty())
+            return pbnjson::JValue();
+
+        return JUtil::parseTrusted(replies.back().c_str());
+    }
+
+    //! check fake binary is run with given arguments
+    static bool isToolRun(const std::string &invocation)
+    {
+        std::vector<std::string> log = testRoot().getToolLog();
+        return std::find(log.begin(), log.end(), invocation) != log.end();
+    }
+};
+
+TEST_F(InstallRemoveTest, InstallWebApp)
+{
+    const std::string appId = "com.example.install";
+    const std::string serviceId = appId + ".service0";
+
+    TaskRunner runner;
+    install(appId, 1, runner);
+
+    const TaskRunner::Result *result = runner.getResult(appId);
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ("InstallTask", result->name);
+    EXPECT_EQ(0, result->errorCode) << result->errorText;
+    EXPECT_TRUE(passedInOrder(result->stepTimes, {
+        IpkParseComplete,
+        GetIpkInfoComplete,
+        AppCloseComplete,
+        IpkInstallComplete,
+        ServiceInstallComplete,
+        InstallSmackComplete,
+        InstallComplete
+    }));
+
+    pbnjson::JValue status = getLastStatus(appId);
+    ASSERT_TRUE(status.isObject());
+    EXPECT_EQ(appId, status["id"].asString());
+    EXPECT_EQ((int) InstallComplete, status["statusValue"].asNumber<int>());
+    EXPECT_EQ("installed", status["details"]["state"].asString());
+    EXPECT_EQ(appId, status["details"]["packageId"].asString());
+    EXPECT_EQ("com.example.test", status["details"]["client"].asString());
+    EXPECT_EQ(testRoot().getInstallPath(), status["details"]["installBasePath"].asString());
+
+    // files unpacked by fake installer and written by appinstalld itself
+    std::string appPath = Settings::instance().getInstallApplicationPath(true) + "/" + appId;
+    std::string manifestPath = Settings::instance().getLunaUnifiedManifestsDir(true, true) + "/" + appId + ".json";
+    EXPECT_TRUE(g_file_test((appPath + "/appinfo.json").c_str(), G_FILE_TEST_EXISTS));
+    EXPECT_TRUE(g_file_test(manifestPath.c_str(), G_FILE_TEST_EXISTS));
+    EXPECT_TRUE(g_file_test((Settings::instance().getSmackRulesDir() + appId).c_str(), G_FILE_TEST_EXISTS));
+    EXPECT_TRUE(g_file_test((Settings::instance().getSmackRulesDir() + serviceId).c_str(), G_FILE_TEST_EXISTS));
+
+    EXPECT_TRUE(isToolRun("smackctl apply"));
+
+    bool manifestAdded = false;
+    for (const auto &call : fakeBus().getCalls()) {
+        if (call.uri == "luna://com.webos.service.bus/addOneManifest")
+            manifestAdded = true;
+    }
+    EXPECT_TRUE(manifestAdded);
+}
+
+TEST_F(InstallRemoveTest, RemoveWebApp)
+{
+    const std::string appId = "com.example.remove";
+    const std::string serviceId = appId + ".service0";
+
+    TaskRunner runner;
+    install(appId, 1, runner);
+    ASSERT_NE(nullptr, runner.getResult(appId));
+    ASSERT_EQ(0, runner.getResult(appId)->errorCode);
+
+    runner.clear();
+    testRoot().clearToolLog();
+    fakeBus().clear();
+    remove(appId, runner);
+
+    const TaskRunner::Result *result = runner.getResult(appId);
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ("RemoveTask", result->name);
+    EXPECT_EQ(0, result->errorCode) << result->errorText;
+    EXPECT_TRUE(passedInOrder(result->stepTimes, {
+        AppCloseComplete,
+        RemoveStarted,
+        RemoveJailComplete,
+        RemoveSmackComplete,
+        ServiceUninstallComplete,
+        IpkRemoveComplete,
+        DataRemoveComplete,
+        RemoveComplete
+    }));
+
+    pbnjson::JValue status = getLastStatus(appId);
+    ASSERT_TRUE(status.isObject());
+    EXPECT_EQ(appId, status["id"].asString());
+    EXPECT_EQ((int) RemoveComplete, status["statusValue"].asNumber<int>());
+    EXPECT_EQ("removed", status["details"]["state"].asString());
+
+    std::string appPath = Settings::instance().getInstallApplicationPath(true) + "/" + appId;
+    std::string manifestPath = Settings::instance().getLunaUnifiedManifestsDir(true, true) + "/" + appId + ".json";
+    EXPECT_FALSE(g_file_test(appPath.c_str(), G_FILE_TEST_EXISTS));
+    EXPECT_FALSE(g_file_test(manifestPath.c_str(), G_FILE_TEST_EXISTS));
+    EXPECT_FALSE(g_file_test((Settings::instance().getSmackRulesDir() + appId).c_str(), G_FILE_TEST_EXISTS));
+
+    EXPECT_TRUE(isToolRun("jailer -D -i " + appId));
+    EXPECT_TRUE(isToolRun("smackctl apply"));
+
+    // nodejs service of the app is asked to quit before it's removed
+    bool serviceQuit = false;
+    for (const auto &call : fakeBus().getCalls()) {
+        if (call.uri == "luna://" + serviceId + "/quit")
+            serviceQuit = true;
+    }
+    EXPECT_TRUE(serviceQuit);
+}
+
+TEST_F(InstallRemoveTest, InstallCorruptedIpk)
+{
+    const std::string appId = "com.example.corrupted";
+    std::string ipkPath = testRoot().getPath() + "/" + appId + ".ipk";
+
+    // payload makes data member most of ipk, so cut is always in it
+    std::string ipk = IpkBuilder(appId).setPayload(1, 64 * 1024).build();
+    ipk.resize(ipk.size() / 2);
+    FILE *file = fopen(ipkPath.c_str(), "w");
+    ASSERT_NE(nullptr, file);
+    fwrite(ipk.data(), 1, ipk.size(), file);
+    fclose(file);
+
+    int errorCode = 0;
+    std::string errorText;
+    TaskRunner runner;
+    ASSERT_TRUE(AppInstaller::instance().install(appId, ipkPath, makeAppInfo(appId), errorCode, errorText));
+    runner.expect(appId);
+    ASSERT_TRUE(runner.wait(TASK_TIMEOUT));
+
+    // control is at the head of ipk, so it's parsed and install fails in opkg phase
+    const TaskRunner::Result *result = runner.getResult(appId);
+    ASSERT_NE(nullptr, result);
+    EXPECT_NE(0, result->errorCode);
+
+    pbnjson::JValue status = getLastStatus(appId);
+    ASSERT_TRUE(status.isObject());
+    EXPECT_EQ(appId, status["id"].asString());
+    EXPECT_TRUE(status["details"]["errorCode"].isNumber());
+    EXPECT_FALSE(isToolRun("smackctl apply"));
+}
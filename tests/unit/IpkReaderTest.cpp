@@ -0,0 +1,106 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <map>
+
+#include "installer/IpkReader.h"
+#include "IpkBuilder.h"
+#include "TestEnv.h"
+
+class IpkReaderTest : public ::testing::Test {
+protected:
+    //! write contents to file under test root and get its path
+    static std::string writeFile(const std::string &name, const std::string &contents)
+    {
+        std::string path = testRoot().getPath() + "/" + name;
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), contents.size());
+        return path;
+    }
+
+    //! strip leading "./" as tar entries are reported
+    static std::string normalize(std::string name)
+    {
+        while (name.compare(0, 2, "./") == 0)
+            name.erase(0, 2);
+        return name;
+    }
+};
+
+TEST_F(IpkReaderTest, ReadControlAndData)
+{
+    IpkBuilder builder("com.example.reader", "1.2.3");
+    builder.setServiceCount(1).setPayload(4, 64 * 1024);
+    std::string path = writeFile("reader.ipk", builder.build());
+
+    IpkReader reader;
+    ASSERT_TRUE(reader.open(path)) << reader.getError();
+
+    std::string control;
+    ASSERT_TRUE(reader.readFile("control.tar.gz", "control", control)) << reader.getError();
+    EXPECT_NE(std::string::npos, control.find("Package: com.example.reader\n"));
+    EXPECT_NE(std::string::npos, control.find("Version: 1.2.3\n"));
+
+    std::map<std::string, std::string> expected;
+    for (const auto &entry : builder.getDataEntries()) {
+        if (entry.type != '5')
+            expected[normalize(entry.name)] = entry.content;
+    }
+
+    std::map<std::string, std::string> entries;
+    ASSERT_TRUE(reader.readEntries("data.tar.gz", [&entries] (const std::string &name, const std::string &content) {
+        entries[name] = content;
+        return true;
+    })) << reader.getError();
+    EXPECT_EQ(expected, entries);
+}
+
+TEST_F(IpkReaderTest, MissingMember)
+{
+    std::string path = writeFile("missing.ipk", IpkBuilder("com.example.missing").build());
+
+    IpkReader reader;
+    ASSERT_TRUE(reader.open(path)) << reader.getError();
+
+    std::string content;
+    EXPECT_FALSE(reader.readFile("control.tar.gz", "postinst", content));
+    EXPECT_FALSE(reader.getError().empty());
+}
+
+TEST_F(IpkReaderTest, TruncatedData)
+{
+    // payload doesn't compress, so cut in the middle of ipk is in data member
+    std::string ipk = IpkBuilder("com.example.truncated").setPayload(1, 64 * 1024).build();
+    ipk.resize(ipk.size() / 2);
+    std::string path = writeFile("truncated.ipk", ipk);
+
+    IpkReader reader;
+    ASSERT_TRUE(reader.open(path)) << reader.getError();
+
+    // control member is whole
+    std::string control;
+    EXPECT_TRUE(reader.readFile("control.tar.gz", "control", control)) << reader.getError();
+
+    size_t count = 0;
+    EXPECT_FALSE(reader.readEntries("data.tar.gz", [&count] (const std::string &name, const std::string &content) {
+        ++count;
+        return true;
+    }));
+    EXPECT_NE(std::string::npos, reader.getError().find("truncated")) << reader.getError();
+}
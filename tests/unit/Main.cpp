@@ -0,0 +1,45 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+
+#include "installer/AppInstaller.h"
+#include "TestEnv.h"
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    std::string errorText;
+    if (!testRoot().setUp(errorText)) {
+        fprintf(stderr, "Failed to set up test root: %s\n", errorText.c_str());
+        return 1;
+    }
+
+    fakeBus().attach();
+    if (!AppInstaller::instance().initialize()) {
+        fprintf(stderr, "Failed to initialize AppInstaller\n");
+        return 1;
+    }
+
+    int result = RUN_ALL_TESTS();
+
+    AppInstaller::instance().finalize();
+    fakeBus().detach();
+    testRoot().tearDown();
+    return result;
+}